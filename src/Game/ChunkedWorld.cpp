@@ -0,0 +1,430 @@
+#include "ChunkedWorld.hpp"
+
+#include "../Renderer/Texture2D.hpp"
+#include "../Renderer/ShaderProgram.hpp"
+#include "../Renderer/RenderQueue.hpp"
+#include "../Renderer/AnimationClipTable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <random>
+
+namespace {
+	const size_t CHUNK_TILES_COUNT = ChunkedWorld::CHUNK_SIZE * ChunkedWorld::CHUNK_SIZE;
+	const size_t HEADER_SIZE = sizeof(ChunkedWorld::MAGIC) + 4 * sizeof(uint32_t);
+
+	bool isValidTile(const char type)
+	{
+		switch (static_cast<Level::ETileType>(type))
+		{
+		case Level::ETileType::Empty:
+		case Level::ETileType::Brick:
+		case Level::ETileType::Steel:
+		case Level::ETileType::Water:
+		case Level::ETileType::Ice:
+		case Level::ETileType::Forest:
+			return true;
+		}
+		return false;
+	}
+}
+
+bool ChunkedWorld::generate(const std::string& path, const unsigned int chunksCountX, const unsigned int chunksCountY, const unsigned int seed)
+{
+	std::ofstream file(path, std::ios::binary);
+	if (!file.is_open())
+	{
+		std::cerr << "Can't write the world file: " << path << std::endl;
+		return false;
+	}
+
+	const uint32_t header[] = { VERSION, CHUNK_SIZE, chunksCountX, chunksCountY };
+	file.write(MAGIC, sizeof(MAGIC));
+	file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+	// 2x2 blocks like the built-in level, most of the map left open
+	const Level::ETileType blockTypes[] = {
+		Level::ETileType::Brick, Level::ETileType::Brick, Level::ETileType::Brick,
+		Level::ETileType::Steel, Level::ETileType::Water, Level::ETileType::Ice, Level::ETileType::Forest
+	};
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<float> fill(0.f, 1.f);
+	std::uniform_int_distribution<size_t> blockType(0, std::size(blockTypes) - 1);
+
+	std::vector<char> chunk(CHUNK_TILES_COUNT);
+	for (size_t i = 0; i < static_cast<size_t>(chunksCountX) * chunksCountY; ++i)
+	{
+		for (unsigned int y = 0; y < CHUNK_SIZE; y += 2)
+		{
+			for (unsigned int x = 0; x < CHUNK_SIZE; x += 2)
+			{
+				const Level::ETileType type = fill(generator) < 0.35f ? blockTypes[blockType(generator)] : Level::ETileType::Empty;
+				chunk[y * CHUNK_SIZE + x] = chunk[y * CHUNK_SIZE + x + 1] = static_cast<char>(type);
+				chunk[(y + 1) * CHUNK_SIZE + x] = chunk[(y + 1) * CHUNK_SIZE + x + 1] = static_cast<char>(type);
+			}
+		}
+		file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+	}
+	return file.good();
+}
+
+size_t ChunkedWorld::Chunk::memoryUsage() const
+{
+	return sizeof(Chunk) + (groundSprites.capacity() + forestSprites.capacity()) * sizeof(TileSprite);
+}
+
+ChunkedWorld::ChunkedWorld(const size_t memoryBudget) :
+	m_memoryBudget(memoryBudget)
+{
+}
+
+ChunkedWorld::~ChunkedWorld()
+{
+	stopLoader();
+}
+
+bool ChunkedWorld::init(const std::string& path,
+						std::shared_ptr<Renderer::Texture2D> pTextureAtlas,
+						std::shared_ptr<Renderer::ShaderProgram> pShaderProgram,
+						Renderer::AnimationClipTable& animationClipTable,
+						const float tileSize)
+{
+	if (!pTextureAtlas || !pShaderProgram)
+	{
+		std::cerr << "Can't init the world without a texture atlas and a shader" << std::endl;
+		return false;
+	}
+
+	m_file.open(path, std::ios::binary);
+	if (!m_file.is_open())
+	{
+		std::cerr << "Can't open the world file: " << path << std::endl;
+		return false;
+	}
+
+	char magic[sizeof(MAGIC)];
+	uint32_t header[4];
+	m_file.read(magic, sizeof(magic));
+	m_file.read(reinterpret_cast<char*>(header), sizeof(header));
+	if (!m_file || std::memcmp(magic, MAGIC, sizeof(magic)) != 0 || header[0] != VERSION || header[1] != CHUNK_SIZE)
+	{
+		std::cerr << "Not a version " << VERSION << " world with " << CHUNK_SIZE << " tile chunks: " << path << std::endl;
+		return false;
+	}
+
+	m_file.seekg(0, std::ios::end);
+	const size_t fileSize = static_cast<size_t>(m_file.tellg());
+	if (fileSize < HEADER_SIZE + static_cast<size_t>(header[2]) * header[3] * CHUNK_TILES_COUNT)
+	{
+		std::cerr << "The world file is truncated: " << path << std::endl;
+		return false;
+	}
+
+	m_chunksCountX = header[2];
+	m_chunksCountY = header[3];
+	m_tileSize = tileSize;
+	m_pTextureAtlas = std::move(pTextureAtlas);
+	m_pShaderProgram = std::move(pShaderProgram);
+
+	m_waterClipID = animationClipTable.addClip(*m_pTextureAtlas, {
+		{ "water1", static_cast<uint64_t>(5e8) },
+		{ "water2", static_cast<uint64_t>(5e8) },
+		{ "water3", static_cast<uint64_t>(5e8) }
+	});
+	auto tileSubTexture = [this](const Level::ETileType type) -> Renderer::Texture2D::SubTexture2D& {
+		return m_tileSubTextures[static_cast<unsigned char>(type)];
+	};
+	tileSubTexture(Level::ETileType::Brick) = m_pTextureAtlas->getSubTexture("block");
+	tileSubTexture(Level::ETileType::Steel) = m_pTextureAtlas->getSubTexture("rock");
+	tileSubTexture(Level::ETileType::Water) = m_pTextureAtlas->getSubTexture("water1");
+	tileSubTexture(Level::ETileType::Ice) = m_pTextureAtlas->getSubTexture("ice");
+	tileSubTexture(Level::ETileType::Forest) = m_pTextureAtlas->getSubTexture("leaf");
+
+	m_loader = std::thread(&ChunkedWorld::runLoader, this);
+	return true;
+}
+
+Renderer::ViewRect ChunkedWorld::bounds() const
+{
+	return Renderer::ViewRect{ glm::vec2(0.f), m_tileSize * glm::vec2(width(), height()) };
+}
+
+bool ChunkedWorld::chunksInRect(const Renderer::ViewRect& rect, unsigned int& firstX, unsigned int& firstY, unsigned int& lastX, unsigned int& lastY) const
+{
+	// in chunks from the bottom-left corner of the world
+	const float chunkSize = m_tileSize * CHUNK_SIZE;
+	const glm::vec2 min = glm::floor(rect.min / chunkSize);
+	const glm::vec2 max = glm::ceil(rect.max / chunkSize) - 1.f;
+	if (max.x < 0.f || max.y < 0.f || min.x >= static_cast<float>(m_chunksCountX) || min.y >= static_cast<float>(m_chunksCountY) || min.x > max.x || min.y > max.y)
+	{
+		return false;
+	}
+
+	firstX = static_cast<unsigned int>(std::max(min.x, 0.f));
+	lastX = static_cast<unsigned int>(std::min(max.x, static_cast<float>(m_chunksCountX - 1)));
+	// chunk row 0 is the top of the world
+	firstY = m_chunksCountY - 1 - static_cast<unsigned int>(std::min(max.y, static_cast<float>(m_chunksCountY - 1)));
+	lastY = m_chunksCountY - 1 - static_cast<unsigned int>(std::max(min.y, 0.f));
+	return true;
+}
+
+void ChunkedWorld::update(const std::vector<Renderer::ViewRect>& views)
+{
+	if (!m_loader.joinable())
+	{
+		return;
+	}
+
+	++m_updatesCount;
+	const glm::vec2 margin(m_tileSize * CHUNK_SIZE);
+	std::unordered_set<uint32_t> neededChunks;
+	for (const Renderer::ViewRect& view : views)
+	{
+		unsigned int firstX, firstY, lastX, lastY;
+		if (!chunksInRect(Renderer::ViewRect{ view.min - margin, view.max + margin }, firstX, firstY, lastX, lastY))
+		{
+			continue;
+		}
+		for (unsigned int y = firstY; y <= lastY; ++y)
+		{
+			for (unsigned int x = firstX; x <= lastX; ++x)
+			{
+				neededChunks.insert(y * m_chunksCountX + x);
+			}
+		}
+	}
+
+	std::vector<LoadResult> results;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		results.swap(m_results);
+
+		// a camera that moved on no longer needs what it asked for
+		auto isStale = [&neededChunks](const LoadRequest& request) { return neededChunks.count(request.chunk) == 0; };
+		for (const LoadRequest& request : m_requests)
+		{
+			if (isStale(request))
+			{
+				m_pendingChunks.erase(request.chunk);
+			}
+		}
+		m_requests.erase(std::remove_if(m_requests.begin(), m_requests.end(), isStale), m_requests.end());
+
+		const Clock::time_point now = Clock::now();
+		for (const uint32_t chunk : neededChunks)
+		{
+			if (!m_residentChunks.count(chunk) && m_pendingChunks.insert(chunk).second)
+			{
+				m_requests.push_back(LoadRequest{ chunk, now });
+			}
+		}
+	}
+	m_condition.notify_one();
+
+	const Clock::time_point now = Clock::now();
+	for (LoadResult& result : results)
+	{
+		m_pendingChunks.erase(result.chunk);
+		// a request cancelled while loading and made again comes back twice
+		if (!result.pChunk || m_residentChunks.count(result.chunk))
+		{
+			continue;
+		}
+
+		const double latency = std::chrono::duration<double, std::milli>(now - result.requestTime).count();
+		++m_stats.loadsCount;
+		m_stats.totalLoadLatency += latency;
+		m_stats.maxLoadLatency = std::max(m_stats.maxLoadLatency, latency);
+		m_stats.residentBytes += result.pChunk->memoryUsage();
+
+		m_recentChunks.push_front(result.chunk);
+		m_residentChunks[result.chunk] = ResidentChunk{ std::move(result.pChunk), m_recentChunks.begin(), 0 };
+	}
+
+	for (const uint32_t chunk : neededChunks)
+	{
+		auto it = m_residentChunks.find(chunk);
+		if (it != m_residentChunks.end())
+		{
+			it->second.neededUpdate = m_updatesCount;
+			m_recentChunks.splice(m_recentChunks.begin(), m_recentChunks, it->second.recentPosition);
+		}
+	}
+
+	// needed chunks are at the front, so eviction stops at the first one
+	while (m_stats.residentBytes > m_memoryBudget && !m_recentChunks.empty())
+	{
+		auto it = m_residentChunks.find(m_recentChunks.back());
+		if (it->second.neededUpdate == m_updatesCount)
+		{
+			break;
+		}
+
+		m_stats.residentBytes -= it->second.pChunk->memoryUsage();
+		++m_stats.evictionsCount;
+		m_recentChunks.pop_back();
+		m_residentChunks.erase(it);
+	}
+
+	m_stats.residentChunksCount = m_residentChunks.size();
+	m_stats.pendingChunksCount = m_pendingChunks.size();
+}
+
+void ChunkedWorld::runLoader()
+{
+	while (true)
+	{
+		LoadRequest request;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this] { return m_isStopping || !m_requests.empty(); });
+			if (m_isStopping)
+			{
+				return;
+			}
+			request = m_requests.front();
+			m_requests.pop_front();
+		}
+
+		std::unique_ptr<Chunk> pChunk = loadChunk(request.chunk);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_results.push_back(LoadResult{ request.chunk, request.requestTime, std::move(pChunk) });
+	}
+}
+
+std::unique_ptr<ChunkedWorld::Chunk> ChunkedWorld::loadChunk(const uint32_t chunk)
+{
+	auto pChunk = std::make_unique<Chunk>();
+	m_file.seekg(static_cast<std::streamoff>(HEADER_SIZE + chunk * CHUNK_TILES_COUNT));
+	m_file.read(reinterpret_cast<char*>(pChunk->tiles.data()), CHUNK_TILES_COUNT);
+	if (!m_file)
+	{
+		std::cerr << "Can't read world chunk " << chunk << std::endl;
+		m_file.clear();
+		return nullptr;
+	}
+
+	// row 0 is the top of the world
+	const unsigned int firstX = (chunk % m_chunksCountX) * CHUNK_SIZE;
+	const unsigned int firstY = (chunk / m_chunksCountX) * CHUNK_SIZE;
+	const unsigned int worldHeight = height();
+	for (unsigned int y = 0; y < CHUNK_SIZE; ++y)
+	{
+		for (unsigned int x = 0; x < CHUNK_SIZE; ++x)
+		{
+			const size_t tileIndex = y * CHUNK_SIZE + x;
+			Level::ETileType& type = pChunk->tiles[tileIndex];
+			if (!isValidTile(static_cast<char>(type)))
+			{
+				type = Level::ETileType::Empty;
+			}
+			if (type == Level::ETileType::Empty)
+			{
+				continue;
+			}
+
+			pChunk->blocking[tileIndex] = type == Level::ETileType::Brick || type == Level::ETileType::Steel || type == Level::ETileType::Water;
+
+			const bool isAnimated = type == Level::ETileType::Water && m_waterClipID >= 0;
+			const TileSprite tileSprite{
+				Renderer::SpriteInstance{ m_tileSize * glm::vec2(firstX + x, worldHeight - 1 - (firstY + y)),
+										  glm::vec2(m_tileSize),
+										  0.f,
+										  m_tileSubTextures[static_cast<unsigned char>(type)] },
+				isAnimated ? m_waterClipID : -1
+			};
+			(type == Level::ETileType::Forest ? pChunk->forestSprites : pChunk->groundSprites).push_back(tileSprite);
+		}
+	}
+	pChunk->groundSprites.shrink_to_fit();
+	pChunk->forestSprites.shrink_to_fit();
+	return pChunk;
+}
+
+void ChunkedWorld::stopLoader()
+{
+	if (!m_loader.joinable())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = true;
+	}
+	m_condition.notify_one();
+	m_loader.join();
+}
+
+void ChunkedWorld::submit(Renderer::RenderQueue& renderQueue, const Renderer::AnimationClipTable& animationClipTable, const float time, const Renderer::ViewRect& view) const
+{
+	unsigned int firstX, firstY, lastX, lastY;
+	if (m_residentChunks.empty() || !chunksInRect(view, firstX, firstY, lastX, lastY))
+	{
+		return;
+	}
+
+	const Renderer::Texture2D::SubTexture2D waterFrame = m_waterClipID >= 0 ? animationClipTable.frame(m_waterClipID, time) : Renderer::Texture2D::SubTexture2D();
+	auto submitSprites = [&](const std::vector<TileSprite>& tileSprites, const Renderer::ERenderLayer renderLayer) {
+		for (const TileSprite& tileSprite : tileSprites)
+		{
+			if (!view.overlaps(tileSprite.instance.position, tileSprite.instance.size))
+			{
+				continue;
+			}
+			if (tileSprite.clipID < 0)
+			{
+				renderQueue.submit(renderLayer, 0.f, *m_pShaderProgram, *m_pTextureAtlas, tileSprite.instance);
+				continue;
+			}
+			Renderer::SpriteInstance instance = tileSprite.instance;
+			instance.subTexture = waterFrame;
+			renderQueue.submit(renderLayer, 0.f, *m_pShaderProgram, *m_pTextureAtlas, instance);
+		}
+	};
+
+	for (unsigned int y = firstY; y <= lastY; ++y)
+	{
+		for (unsigned int x = firstX; x <= lastX; ++x)
+		{
+			auto it = m_residentChunks.find(y * m_chunksCountX + x);
+			if (it != m_residentChunks.end())
+			{
+				submitSprites(it->second.pChunk->groundSprites, Renderer::ERenderLayer::Ground);
+				submitSprites(it->second.pChunk->forestSprites, Renderer::ERenderLayer::Forest);
+			}
+		}
+	}
+}
+
+const ChunkedWorld::Chunk* ChunkedWorld::findChunk(const unsigned int x, const unsigned int y) const
+{
+	if (x >= width() || y >= height())
+	{
+		return nullptr;
+	}
+
+	auto it = m_residentChunks.find((y / CHUNK_SIZE) * m_chunksCountX + x / CHUNK_SIZE);
+	return it != m_residentChunks.end() ? it->second.pChunk.get() : nullptr;
+}
+
+Level::ETileType ChunkedWorld::tileType(const unsigned int x, const unsigned int y) const
+{
+	const Chunk* pChunk = findChunk(x, y);
+	return pChunk ? pChunk->tiles[(y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE] : Level::ETileType::Empty;
+}
+
+bool ChunkedWorld::isResident(const unsigned int x, const unsigned int y) const
+{
+	return findChunk(x, y) != nullptr;
+}
+
+bool ChunkedWorld::isBlocking(const unsigned int x, const unsigned int y) const
+{
+	const Chunk* pChunk = findChunk(x, y);
+	return pChunk && pChunk->blocking[(y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE];
+}
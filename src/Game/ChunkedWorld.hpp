@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Level.hpp"
+#include "../Renderer/Camera.hpp"
+#include "../Renderer/Sprite.hpp"
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Renderer {
+	class Texture2D;
+	class ShaderProgram;
+	class AnimationClipTable;
+	class RenderQueue;
+}
+
+// Tile map of any size streamed from a file in square chunks. A loader
+// thread reads the chunks the cameras need and builds their sprites and
+// collision masks; update() takes finished chunks in and, over the memory
+// budget, evicts the least recently needed ones outside every view. A file
+// is a header followed by every chunk, both row by row from the top left:
+//   char magic[8] | uint32 version | uint32 chunkSize | uint32 chunksCountX | uint32 chunksCountY
+//   chunksCountX * chunksCountY chunks of chunkSize * chunkSize Level::ETileType characters
+class ChunkedWorld {
+public:
+	static constexpr char MAGIC[8] = { 'B', 'C', 'W', 'O', 'R', 'L', 'D', '\0' };
+	static constexpr uint32_t VERSION = 1;
+	static constexpr unsigned int CHUNK_SIZE = 32;
+	static constexpr size_t DEFAULT_MEMORY_BUDGET = 16 << 20;
+
+	struct Stats {
+		size_t residentChunksCount = 0;
+		size_t residentBytes = 0;
+		size_t pendingChunksCount = 0;
+		size_t loadsCount = 0;
+		size_t evictionsCount = 0;
+		// from the request to the chunk being usable, milliseconds
+		double totalLoadLatency = 0.0;
+		double maxLoadLatency = 0.0;
+
+		double averageLoadLatency() const { return loadsCount ? totalLoadLatency / loadsCount : 0.0; }
+	};
+
+	// writes a random world of chunksCountX x chunksCountY chunks
+	static bool generate(const std::string& path, const unsigned int chunksCountX, const unsigned int chunksCountY, const unsigned int seed = 1);
+
+	ChunkedWorld(const size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+	~ChunkedWorld();
+
+	ChunkedWorld(const ChunkedWorld&) = delete;
+	ChunkedWorld& operator=(const ChunkedWorld&) = delete;
+
+	// opens the file and starts the loader; no chunk is read before the first update
+	bool init(const std::string& path,
+			  std::shared_ptr<Renderer::Texture2D> pTextureAtlas,
+			  std::shared_ptr<Renderer::ShaderProgram> pShaderProgram,
+			  Renderer::AnimationClipTable& animationClipTable,
+			  const float tileSize);
+
+	// requests the chunks within a chunk of any view, takes finished ones in and evicts over the budget
+	void update(const std::vector<Renderer::ViewRect>& views);
+	// resident tiles in view, ground to ERenderLayer::Ground and forest to ERenderLayer::Forest
+	void submit(Renderer::RenderQueue& renderQueue, const Renderer::AnimationClipTable& animationClipTable, const float time, const Renderer::ViewRect& view) const;
+
+	// tiles of chunks that are not resident are Empty
+	Level::ETileType tileType(const unsigned int x, const unsigned int y) const;
+	bool isResident(const unsigned int x, const unsigned int y) const;
+	// bricks, steel and water stop tanks
+	bool isBlocking(const unsigned int x, const unsigned int y) const;
+
+	unsigned int width() const { return m_chunksCountX * CHUNK_SIZE; }
+	unsigned int height() const { return m_chunksCountY * CHUNK_SIZE; }
+	// the world in world units, the bottom left at the origin
+	Renderer::ViewRect bounds() const;
+
+	void setMemoryBudget(const size_t memoryBudget) { m_memoryBudget = memoryBudget; }
+	size_t memoryBudget() const { return m_memoryBudget; }
+	const Stats& stats() const { return m_stats; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct TileSprite {
+		Renderer::SpriteInstance instance;
+		int clipID;
+	};
+
+	struct Chunk {
+		std::array<Level::ETileType, CHUNK_SIZE * CHUNK_SIZE> tiles;
+		std::bitset<CHUNK_SIZE * CHUNK_SIZE> blocking;
+		std::vector<TileSprite> groundSprites;
+		std::vector<TileSprite> forestSprites;
+
+		size_t memoryUsage() const;
+	};
+
+	struct ResidentChunk {
+		std::unique_ptr<Chunk> pChunk;
+		// in m_recentChunks
+		std::list<uint32_t>::iterator recentPosition;
+		uint64_t neededUpdate = 0;
+	};
+
+	struct LoadRequest {
+		uint32_t chunk;
+		Clock::time_point requestTime;
+	};
+
+	struct LoadResult {
+		uint32_t chunk;
+		Clock::time_point requestTime;
+		std::unique_ptr<Chunk> pChunk;
+	};
+
+	void runLoader();
+	std::unique_ptr<Chunk> loadChunk(const uint32_t chunk);
+	void stopLoader();
+	const Chunk* findChunk(const unsigned int x, const unsigned int y) const;
+	// inclusive chunk range overlapping rect, false if there is none
+	bool chunksInRect(const Renderer::ViewRect& rect, unsigned int& firstX, unsigned int& firstY, unsigned int& lastX, unsigned int& lastY) const;
+
+	unsigned int m_chunksCountX = 0;
+	unsigned int m_chunksCountY = 0;
+	float m_tileSize = 0.f;
+	std::shared_ptr<Renderer::Texture2D> m_pTextureAtlas;
+	std::shared_ptr<Renderer::ShaderProgram> m_pShaderProgram;
+	int m_waterClipID = -1;
+	// resolved up front, the loader doesn't look names up
+	std::array<Renderer::Texture2D::SubTexture2D, 256> m_tileSubTextures{};
+
+	size_t m_memoryBudget;
+	uint64_t m_updatesCount = 0;
+	std::unordered_map<uint32_t, ResidentChunk> m_residentChunks;
+	// most recently needed first
+	std::list<uint32_t> m_recentChunks;
+	std::unordered_set<uint32_t> m_pendingChunks;
+	Stats m_stats;
+
+	// loader side, everything below m_mutex is shared with it
+	std::ifstream m_file;
+	std::thread m_loader;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<LoadRequest> m_requests;
+	std::vector<LoadResult> m_results;
+	bool m_isStopping = false;
+};
@@ -5,12 +5,58 @@
 #include "../Renderer/Texture2D.hpp"
 #include "../Renderer/Sprite.hpp"
 #include "../Renderer/AnimatedSprite.hpp"
+#include "../Renderer/SpriteBatch.hpp"
+#include "../Renderer/StreamBuffer.hpp"
+#include "../Renderer/FrameBuffer.hpp"
+#include "../Renderer/RenderBackend.hpp"
+#include "../Renderer/RenderQueue.hpp"
+#include "../Renderer/RenderSnapshot.hpp"
+#include "../Renderer/SnapshotBuffer.hpp"
+#include "../Renderer/CommandRecorder.hpp"
+#include "../Renderer/UniformBuffer.hpp"
+#include "../Renderer/FrameData.hpp"
+#include "../Renderer/AnimationClipTable.hpp"
+#include "../Renderer/GpuProfiler.hpp"
+#include "../Renderer/Camera.hpp"
+#include "../Renderer/VisibilityGrid.hpp"
+#include "../Renderer/ParticleSystem.hpp"
+#include "Level.hpp"
+#include "ChunkedWorld.hpp"
+#include "Hud.hpp"
 
 #include <glm/mat4x4.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <GLFW/glfw3.h>
 
+#include <algorithm>
 #include <iostream>
 
+namespace {
+	const std::vector<std::string> LEVEL_DESCRIPTION = {
+		".............",
+		".B.B.B.B.B.B.",
+		".B.B.B.B.B.B.",
+		".B.B.BSB.B.B.",
+		".B.B.B.B.B.B.",
+		"FF...B.B...FF",
+		"S.BB.....BB.S",
+		"FF...B.B...FF",
+		".B.BWWWWWB.B.",
+		".B.B.B.B.B.B.",
+		".B.B.....B.B.",
+		".B.B.BBB.B.B.",
+		"IIIII.B.IIIII"
+	};
+
+	const float LEVEL_TILE_SIZE = 8.f;
+	// per-frame region of the streaming vertex buffer, 26214 sprite quads
+	const GLsizeiptr STREAM_BUFFER_REGION_SIZE = 1 << 20;
+	// a tile chunk of TileMapRenderer
+	const float VISIBILITY_CELL_SIZE = 64.f;
+	// native pixels per second, arrow keys scroll maps larger than the screen
+	const float CAMERA_SPEED = 128.f;
+}
+
 Game::Game(const glm::vec2& windowSize): 
 	m_eCurrentGameState(EGameState::Active), 
 	m_windowSize(windowSize)
@@ -25,20 +71,247 @@ Game::~Game()
 
 void Game::render() 
 {
-	ResourceManager::getAnimatedSprite("NewAnimatedSprite")->render();
+	// keeps the previous snapshot when no new one was published
+	m_pSnapshots->acquire();
+	const Renderer::RenderSnapshot& snapshot = m_pSnapshots->readBuffer();
+
+	if (Renderer::RenderBackend::current().type() == Renderer::RenderBackend::EType::Software)
+	{
+		Renderer::RenderBackend::current().drawQueue(snapshot.renderQueue, snapshot.camera.position());
+		m_renderedSnapshotIndex = snapshot.index;
+		return;
+	}
+
+	using EPass = Renderer::GpuProfiler::EPass;
+
+	// the level's GPU map and the clip table are changed only here, from the snapshot
+	const uint64_t renderedSnapshotIndex = m_renderedSnapshotIndex;
+	if (snapshot.index != renderedSnapshotIndex)
+	{
+		if (m_pLevel)
+		{
+			m_pLevel->applyTileEdits(snapshot.tileEdits, renderedSnapshotIndex);
+		}
+		m_pAnimationClipTable->upload(snapshot.pAnimationClips);
+		m_renderedSnapshotIndex = snapshot.index;
+	}
+
+	m_pGpuProfiler->beginFrame();
+	updateFrameData(snapshot.time, snapshot.camera);
+
+	m_pFrameBuffer->bind();
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	m_pGpuProfiler->beginPass(EPass::Map);
+	const Renderer::ViewRect view = snapshot.camera.viewRect();
+	if (m_pLevel)
+	{
+		m_pLevel->renderGround(view);
+	}
+	m_pGpuProfiler->endPass(EPass::Map);
+
+	m_pGpuProfiler->beginPass(EPass::Sprites);
+	m_pSpriteBatch->begin();
+	snapshot.renderQueue.emit(*m_pSpriteBatch, Renderer::ERenderLayer::Ground, Renderer::ERenderLayer::Bullets);
+	m_pSpriteBatch->end();
+	m_pGpuProfiler->endPass(EPass::Sprites);
+
+	m_pGpuProfiler->beginPass(EPass::Map);
+	if (m_pLevel)
+	{
+		m_pLevel->renderForest(view);
+	}
+	m_pGpuProfiler->endPass(EPass::Map);
+
+	m_pGpuProfiler->beginPass(EPass::Sprites);
+	m_pSpriteBatch->begin();
+	snapshot.renderQueue.emit(*m_pSpriteBatch, Renderer::ERenderLayer::Forest, Renderer::ERenderLayer::Forest);
+	m_pSpriteBatch->end();
+	m_pGpuProfiler->endPass(EPass::Sprites);
+
+	m_pGpuProfiler->beginPass(EPass::HUD);
+	m_pSpriteBatch->begin();
+	snapshot.renderQueue.emit(*m_pSpriteBatch, Renderer::ERenderLayer::HUD, Renderer::ERenderLayer::HUD);
+	m_pSpriteBatch->end();
+	m_pGpuProfiler->endPass(EPass::HUD);
+
+	m_pStreamBuffer->endFrame();
+
+	m_pGpuProfiler->beginPass(EPass::Upscale);
+	m_pFrameBuffer->blitTo(m_outputFramebuffer, static_cast<unsigned int>(snapshot.windowSize.x), static_cast<unsigned int>(snapshot.windowSize.y));
+	m_pGpuProfiler->endPass(EPass::Upscale);
+	m_pGpuProfiler->endFrame();
+}
+
+bool Game::waitForSnapshot()
+{
+	return m_pSnapshots->waitAndAcquire();
+}
+
+void Game::waitUntilSnapshotTaken()
+{
+	m_pSnapshots->waitUntilAcquired();
+}
+
+void Game::stopRendering()
+{
+	m_pSnapshots->stop();
+}
+
+void Game::publishSnapshot()
+{
+	Renderer::RenderSnapshot& snapshot = m_pSnapshots->writeBuffer();
+	snapshot.windowSize = m_windowSize;
+	snapshot.time = static_cast<float>(m_time * 1e-9);
+	snapshot.camera = *m_pCamera;
+	snapshot.index = ++m_publishedSnapshotsCount;
+	snapshot.pAnimationClips = m_pAnimationClipTable->data();
+	const Renderer::ViewRect view = m_pCamera->viewRect();
+
+	if (m_pLevel)
+	{
+		const uint64_t renderedSnapshotIndex = m_renderedSnapshotIndex;
+		m_tileEditsLog.erase(m_tileEditsLog.begin(), std::find_if(m_tileEditsLog.begin(), m_tileEditsLog.end(), [renderedSnapshotIndex](const Renderer::TileEdit& tileEdit) {
+			return tileEdit.snapshotIndex > renderedSnapshotIndex;
+		}));
+		const size_t firstNewEdit = m_tileEditsLog.size();
+		m_pLevel->takeTileEdits(m_tileEditsLog);
+		for (size_t i = firstNewEdit; i < m_tileEditsLog.size(); ++i)
+		{
+			m_tileEditsLog[i].snapshotIndex = snapshot.index;
+		}
+		snapshot.tileEdits = m_tileEditsLog;
+	}
+
+	Renderer::RenderQueue& renderQueue = snapshot.renderQueue;
+	renderQueue.clear();
+	if (m_pWorld)
+	{
+		m_pWorld->submit(renderQueue, *m_pAnimationClipTable, snapshot.time, view);
+	}
+	else if (Renderer::RenderBackend::current().type() == Renderer::RenderBackend::EType::Software)
+	{
+		// the OpenGL path keeps the level on the GPU and animates it in the tile shader;
+		// here the map is drawn on the update side, so the edits are applied here too
+		m_pLevel->applyTileEdits(snapshot.tileEdits, snapshot.index - 1);
+		m_pLevel->submit(renderQueue, *m_pAnimationClipTable, snapshot.time, view);
+	}
+
+	// in registration order, so sprites sharing a layer and depth keep their order
+	m_visibleSprites.clear();
+	m_pVisibilityGrid->query(view, m_visibleSprites);
+	std::sort(m_visibleSprites.begin(), m_visibleSprites.end());
+	m_pCommandRecorder->record(renderQueue, m_visibleSprites.size(), [this](Renderer::RenderQueue& commandBuffer, const size_t first, const size_t last) {
+		for (size_t i = first; i < last; ++i)
+		{
+			m_sprites[m_visibleSprites[i]]->submit(commandBuffer, Renderer::ERenderLayer::Tanks);
+		}
+	});
+	m_pParticles->submit(renderQueue, Renderer::ERenderLayer::Bullets);
+	m_pHud->submit(renderQueue, m_pCamera->position());
+	renderQueue.sort();
+
+	m_pSnapshots->publish();
 }
 
 void Game::update(const uint64_t delta) 
 {
+	m_time += delta;
+
+	const glm::vec2 direction((m_keys[GLFW_KEY_RIGHT] ? 1.f : 0.f) - (m_keys[GLFW_KEY_LEFT] ? 1.f : 0.f),
+							  (m_keys[GLFW_KEY_UP] ? 1.f : 0.f) - (m_keys[GLFW_KEY_DOWN] ? 1.f : 0.f));
+	if (direction != glm::vec2(0.f))
+	{
+		m_pCamera->move(direction * CAMERA_SPEED * static_cast<float>(delta * 1e-9));
+	}
+	if (m_pWorld)
+	{
+		m_pWorld->update({ m_pCamera->viewRect() });
+	}
+
 	ResourceManager::getAnimatedSprite("NewAnimatedSprite")->update(delta);
+	m_pParticles->update(delta);
+	m_pHud->update(delta);
+
+	publishSnapshot();
 }
 
 void Game::setKey(const int key, const int action) 
 {
 	m_keys[key] = action;
+
+	if (key == GLFW_KEY_SPACE && action == GLFW_PRESS)
+	{
+		const Renderer::Sprite& tank = *ResourceManager::getSprite("PlayerTank");
+		m_pParticles->emit(Renderer::ParticleSystem::EXPLOSION, tank.position() + 0.5f * tank.size());
+	}
+	if (key == GLFW_KEY_B && action == GLFW_PRESS)
+	{
+		destroyNextBrick();
+	}
 }
 
-bool Game::init() 
+void Game::destroyNextBrick()
+{
+	if (!m_pLevel)
+	{
+		return;
+	}
+
+	for (unsigned int y = 0; y < m_pLevel->height(); ++y)
+	{
+		for (unsigned int x = 0; x < m_pLevel->width(); ++x)
+		{
+			if (m_pLevel->tileType(x, y) == Level::ETileType::Brick)
+			{
+				m_pLevel->destroyBrick(x, y, Level::EBrickQuarter::All);
+				return;
+			}
+		}
+	}
+}
+
+void Game::setWindowSize(const glm::vec2& windowSize)
+{
+	m_windowSize = windowSize;
+}
+
+void Game::setOutputFramebuffer(const GLuint framebuffer)
+{
+	m_outputFramebuffer = framebuffer;
+}
+
+void Game::readNativePixels(std::vector<unsigned char>& pixels) const
+{
+	m_pFrameBuffer->readPixels(pixels);
+}
+
+void Game::setOverlayVisible(const bool isVisible)
+{
+	m_pHud->setOverlayVisible(isVisible);
+}
+
+bool Game::isOverlayVisible() const
+{
+	return m_pHud->isOverlayVisible();
+}
+
+void Game::setRenderStats(const Renderer::RenderStats::Counters& counters)
+{
+	m_pHud->setRenderStats(counters);
+}
+
+void Game::updateFrameData(const float time, const Renderer::Camera& camera)
+{
+	Renderer::FrameData frameData{};
+	frameData.projection = camera.projection();
+	frameData.viewport = glm::vec4(0.f, 0.f, NATIVE_WIDTH, NATIVE_HEIGHT);
+	frameData.time = time;
+
+	m_pFrameDataBuffer->update(&frameData, sizeof(frameData));
+}
+
+bool Game::init(const std::string& worldPath, const size_t worldMemoryBudget)
 {
 	auto pDefaultShaderProgram = ResourceManager::loadShaders("DefaultShader", "res/Shaders/vertex.txt", "res/Shaders/fragment.txt");
 	if (!pDefaultShaderProgram) {
@@ -52,6 +325,12 @@ bool Game::init()
 		return false;
 	}
 
+	auto pTileShaderProgram = ResourceManager::loadShaders("TileShader", "res/Shaders/vTile.txt", "res/Shaders/fSprite.txt");
+	if (!pTileShaderProgram) {
+		std::cerr << "Can't create shader program: " << "TileShader" << std::endl;
+		return false;
+	}
+
 	auto tex = ResourceManager::loadTexture("DefaultTexture", "res/Textures/map_16x16.png");
 
 	std::vector<std::string> subTexturesNames = {
@@ -83,12 +362,33 @@ bool Game::init()
 		"respawn",
 		"nothing",
 	};
-	auto pTextureAtlas = ResourceManager::loadTextureAtlas("DefaultTextureAtlas", "res/Textures/map_8x8.png", std::move(subTexturesNames), 8, 8);
+	std::vector<std::string> tanksSubTexturesNames = {
+		"yellowTankTop1",
+		"yellowTankTop2",
+		"yellowTankLeft1",
+		"yellowTankLeft2",
+		"yellowTankBottom1",
+		"yellowTankBottom2",
+		"yellowTankRight1",
+		"yellowTankRight2",
+	};
+	// map tiles and tanks share one texture array, so both sheets go out in the same batch
+	auto pTextureAtlas = ResourceManager::loadTextureAtlasArray("DefaultTextureAtlas", {
+		{ "res/Textures/map_8x8.png", std::move(subTexturesNames), 8, 8 },
+		{ "res/Textures/tanks.png", std::move(tanksSubTexturesNames), 16, 16 }
+	});
+	if (!pTextureAtlas) {
+		std::cerr << "Can't load texture atlas: " << "DefaultTextureAtlas" << std::endl;
+		return false;
+	}
+
+	auto pSprite = ResourceManager::loadSprite("NewSprite", "DefaultTextureAtlas", "SpriteShader", 16, 16, "topBottomLeftBlock");
+	pSprite->setPosition(glm::vec2(236, 32));
 
-	auto pSprite = ResourceManager::loadSprite("NewSprite", "DefaultTextureAtlas", "SpriteShader", 100, 100, "topBottomLeftBlock");
-	pSprite->setPosition(glm::vec2(300, 100));
+	auto pTankSprite = ResourceManager::loadSprite("PlayerTank", "DefaultTextureAtlas", "SpriteShader", 16, 16, "yellowTankTop1");
+	pTankSprite->setPosition(glm::vec2(104, 8));
 
-	auto pAnimatedSprite = ResourceManager::loadAnimatedSprite("NewAnimatedSprite", "DefaultTextureAtlas", "SpriteShader", 50, 50);
+	auto pAnimatedSprite = ResourceManager::loadAnimatedSprite("NewAnimatedSprite", "DefaultTextureAtlas", "SpriteShader", 16, 16);
 
 	std::vector<std::pair<std::string, uint64_t>> waterState;
 	waterState.emplace_back(std::pair<std::string, uint64_t>("water1", 5e8));
@@ -99,7 +399,7 @@ bool Game::init()
 	pAnimatedSprite->insertState("waterState", std::move(waterState));
 
 	pAnimatedSprite->setState("waterState");
-	pAnimatedSprite->setPosition(glm::vec2(300, 300));
+	pAnimatedSprite->setPosition(glm::vec2(236, 8));
 
 	pDefaultShaderProgram->use();
 	pDefaultShaderProgram->setInt("tex", 0);
@@ -110,18 +410,58 @@ bool Game::init()
 	glm::mat4 modelMatrix_2 = glm::mat4(1.f);
 	modelMatrix_2 = glm::translate(modelMatrix_2, glm::vec3(590.f, 200.f, 0.f));
 
-	glm::mat4 projectionMatrix = glm::ortho(0.f,
-											static_cast<float>(m_windowSize.x),
-											0.f,
-											static_cast<float>(m_windowSize.y),
-											-100.f,
-											100.f);
-
-	pDefaultShaderProgram->setMatrix4("projectionMat", projectionMatrix);
-
 	pSpriteShaderProgram->use();
 	pSpriteShaderProgram->setInt("tex", 0);
-	pSpriteShaderProgram->setMatrix4("projectionMat", projectionMatrix);
+
+	if (Renderer::RenderBackend::current().type() != Renderer::RenderBackend::EType::Software)
+	{
+		m_pFrameBuffer = std::make_unique<Renderer::FrameBuffer>(NATIVE_WIDTH, NATIVE_HEIGHT);
+		m_pFrameDataBuffer = std::make_unique<Renderer::UniformBuffer>(sizeof(Renderer::FrameData), Renderer::FrameData::BINDING_POINT);
+		updateFrameData(0.f, Renderer::Camera(glm::vec2(NATIVE_WIDTH, NATIVE_HEIGHT)));
+
+		m_pStreamBuffer = std::make_unique<Renderer::StreamBuffer>(GL_ARRAY_BUFFER, STREAM_BUFFER_REGION_SIZE);
+		m_pSpriteBatch = std::make_unique<Renderer::SpriteBatch>(*m_pStreamBuffer);
+		m_pGpuProfiler = std::make_unique<Renderer::GpuProfiler>();
+	}
+	m_pSnapshots = std::make_unique<Renderer::SnapshotBuffer<Renderer::RenderSnapshot>>();
+	m_pCommandRecorder = std::make_unique<Renderer::CommandRecorder>();
+	m_sprites = { ResourceManager::getSprite("PlayerTank").get(), ResourceManager::getAnimatedSprite("NewAnimatedSprite").get() };
+	m_pCamera = std::make_unique<Renderer::Camera>(glm::vec2(NATIVE_WIDTH, NATIVE_HEIGHT));
+	m_pHud = std::make_unique<Hud>(pSpriteShaderProgram, glm::vec2(NATIVE_WIDTH, NATIVE_HEIGHT));
+	m_pParticles = std::make_unique<Renderer::ParticleSystem>(pSpriteShaderProgram);
+	m_pParticles->emit(Renderer::ParticleSystem::SPAWN_SPARKLE, pTankSprite->position() + 0.5f * pTankSprite->size());
+
+	pTileShaderProgram->setInt("tex", 0);
+	m_pAnimationClipTable = std::make_unique<Renderer::AnimationClipTable>();
+
+	Renderer::ViewRect worldBounds;
+	if (!worldPath.empty())
+	{
+		// world tiles go through the render queue on every backend
+		m_pWorld = std::make_unique<ChunkedWorld>(worldMemoryBudget);
+		if (!m_pWorld->init(worldPath, pTextureAtlas, pSpriteShaderProgram, *m_pAnimationClipTable, LEVEL_TILE_SIZE))
+		{
+			return false;
+		}
+		worldBounds = m_pWorld->bounds();
+	}
+	else
+	{
+		m_pLevel = std::make_unique<Level>(LEVEL_DESCRIPTION);
+		const glm::vec2 levelSize = LEVEL_TILE_SIZE * glm::vec2(m_pLevel->width(), m_pLevel->height());
+		if (!m_pLevel->init(pTextureAtlas, pTileShaderProgram, *m_pAnimationClipTable, LEVEL_TILE_SIZE, 0.5f * (glm::vec2(NATIVE_WIDTH, NATIVE_HEIGHT) - levelSize)))
+		{
+			return false;
+		}
+		worldBounds = m_pLevel->bounds();
+	}
+
+	m_pCamera->setBounds(worldBounds);
+	m_pVisibilityGrid = std::make_unique<Renderer::VisibilityGrid>(worldBounds, VISIBILITY_CELL_SIZE);
+	for (size_t i = 0; i < m_sprites.size(); ++i)
+	{
+		m_pVisibilityGrid->insert(static_cast<uint32_t>(i), m_sprites[i]->position(), m_sprites[i]->size());
+	}
 
 	return true;
 }
\ No newline at end of file
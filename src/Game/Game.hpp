@@ -1,18 +1,81 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
 #include <glm/vec2.hpp>
 
+#include "../Renderer/RenderStats.hpp"
+
+namespace Renderer {
+	class SpriteBatch;
+	class StreamBuffer;
+	class FrameBuffer;
+	struct RenderSnapshot;
+	struct TileEdit;
+	template <typename T> class SnapshotBuffer;
+	class UniformBuffer;
+	class AnimationClipTable;
+	class GpuProfiler;
+	class CommandRecorder;
+	class Sprite;
+	class Camera;
+	class VisibilityGrid;
+	class ParticleSystem;
+}
+
+class Level;
+class ChunkedWorld;
+class Hud;
+
 class Game {
 public:
+	// the game is drawn at the NES resolution and scaled up to the window
+	static constexpr unsigned int NATIVE_WIDTH = 256;
+	static constexpr unsigned int NATIVE_HEIGHT = 224;
+
 	Game(const glm::vec2& windowSize);
 	~Game();
 
+	// Draws the latest snapshot published by update(). With the software
+	// backend the frame goes to RenderBackend::drawQueue as one sorted queue.
+	// May run on its own thread, which then owns the GL context.
 	void render();
+	// simulates and publishes a render snapshot of the result
 	void update(const uint64_t delta);
+	// render thread: blocks until update() publishes, false once rendering is stopped
+	bool waitForSnapshot();
+	// update thread: blocks until the render thread has taken the last snapshot
+	void waitUntilSnapshotTaken();
+	void stopRendering();
 	void setKey(const int key, const int action);
-	bool init();
+	void setWindowSize(const glm::vec2& windowSize);
+	// framebuffer the native image is presented to, 0 for the window
+	void setOutputFramebuffer(const GLuint framebuffer);
+	// OpenGL backend only
+	void readNativePixels(std::vector<unsigned char>& pixels) const;
+	// nullptr with the software backend
+	const Renderer::GpuProfiler* gpuProfiler() const { return m_pGpuProfiler.get(); }
+	// a world file made with ChunkedWorld::generate replaces the built-in level
+	bool init(const std::string& worldPath = std::string(), const size_t worldMemoryBudget = 16 << 20);
+	// nullptr without a world file
+	const ChunkedWorld* world() const { return m_pWorld.get(); }
+	// nullptr with a world file
+	const Level* level() const { return m_pLevel.get(); }
+	// frame rate and render counters over the level, F3
+	void setOverlayVisible(const bool isVisible);
+	bool isOverlayVisible() const;
+	// counters of the last rendered frame for the overlay
+	void setRenderStats(const Renderer::RenderStats::Counters& counters);
 private:
+	void updateFrameData(const float time, const Renderer::Camera& camera);
+	void publishSnapshot();
+	// debug: B knocks out the first brick left in the level description
+	void destroyNextBrick();
+
 	std::array<bool, 349> m_keys;
 
 	enum class EGameState {
@@ -21,5 +84,29 @@ private:
 	};
 
 	glm::vec2 m_windowSize;
+	GLuint m_outputFramebuffer = 0;
 	EGameState m_eCurrentGameState;
+	std::unique_ptr<Renderer::FrameBuffer> m_pFrameBuffer;
+	std::unique_ptr<Renderer::StreamBuffer> m_pStreamBuffer;
+	std::unique_ptr<Renderer::SpriteBatch> m_pSpriteBatch;
+	std::unique_ptr<Renderer::SnapshotBuffer<Renderer::RenderSnapshot>> m_pSnapshots;
+	std::unique_ptr<Renderer::CommandRecorder> m_pCommandRecorder;
+	// everything submitted to the render queue besides the level, indexed by visibility grid ids
+	std::vector<const Renderer::Sprite*> m_sprites;
+	std::unique_ptr<Renderer::Camera> m_pCamera;
+	std::unique_ptr<Renderer::VisibilityGrid> m_pVisibilityGrid;
+	std::vector<uint32_t> m_visibleSprites;
+	std::unique_ptr<Level> m_pLevel;
+	std::unique_ptr<ChunkedWorld> m_pWorld;
+	std::unique_ptr<Hud> m_pHud;
+	std::unique_ptr<Renderer::ParticleSystem> m_pParticles;
+	std::unique_ptr<Renderer::UniformBuffer> m_pFrameDataBuffer;
+	std::unique_ptr<Renderer::AnimationClipTable> m_pAnimationClipTable;
+	std::unique_ptr<Renderer::GpuProfiler> m_pGpuProfiler;
+	uint64_t m_time = 0;
+	uint64_t m_publishedSnapshotsCount = 0;
+	// update side: tile edits until the render side has drawn a snapshot carrying them
+	std::vector<Renderer::TileEdit> m_tileEditsLog;
+	// written by the render side once it has applied a snapshot's edits
+	std::atomic<uint64_t> m_renderedSnapshotIndex{ 0 };
 };
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "Hud.hpp"
+
+#include "../Renderer/BitmapFont.hpp"
+#include "../Renderer/ShaderProgram.hpp"
+#include "../Renderer/RenderQueue.hpp"
+
+#include <charconv>
+
+namespace {
+	// the strip above the level
+	const float TOP_LINE_MARGIN = 1.f;
+	const float SIDE_MARGIN = 24.f;
+	// the overlay sits inside the level's top left corner
+	const glm::vec2 OVERLAY_POSITION(26.f, 214.f);
+	// frame rate is averaged over this long, nanoseconds
+	const uint64_t FRAME_RATE_PERIOD = 500000000;
+}
+
+class Hud::TextBuilder {
+public:
+	TextBuilder(std::array<char, 128>& buffer) :
+		m_buffer(buffer)
+	{
+	}
+
+	TextBuilder& operator<<(const std::string_view text)
+	{
+		for (const char character : text)
+		{
+			if (m_length < m_buffer.size())
+			{
+				m_buffer[m_length++] = character;
+			}
+		}
+		return *this;
+	}
+
+	TextBuilder& operator<<(const size_t value)
+	{
+		const auto result = std::to_chars(m_buffer.data() + m_length, m_buffer.data() + m_buffer.size(), value);
+		if (result.ec == std::errc())
+		{
+			m_length = static_cast<size_t>(result.ptr - m_buffer.data());
+		}
+		return *this;
+	}
+
+	// value in tenths, shown with one decimal
+	TextBuilder& appendTenths(const size_t tenths)
+	{
+		*this << tenths / 10 << ".";
+		return *this << tenths % 10;
+	}
+
+	std::string_view text() const { return std::string_view(m_buffer.data(), m_length); }
+
+private:
+	std::array<char, 128>& m_buffer;
+	size_t m_length = 0;
+};
+
+Hud::Hud(std::shared_ptr<Renderer::ShaderProgram> pShaderProgram, const glm::vec2& screenSize) :
+	m_pFont(std::make_shared<Renderer::BitmapFont>()),
+	m_screenSize(screenSize),
+	m_scoreLabel(m_pFont, pShaderProgram, glm::vec2(SIDE_MARGIN, screenSize.y - TOP_LINE_MARGIN)),
+	m_livesLabel(m_pFont, pShaderProgram, glm::vec2(0.5f * screenSize.x - 2.f * Renderer::BitmapFont::ADVANCE, screenSize.y - TOP_LINE_MARGIN)),
+	m_stageLabel(m_pFont, pShaderProgram, glm::vec2(0.f, screenSize.y - TOP_LINE_MARGIN)),
+	m_frameRateLabel(m_pFont, pShaderProgram, OVERLAY_POSITION),
+	m_renderStatsLabel(m_pFont, pShaderProgram, OVERLAY_POSITION - glm::vec2(0.f, Renderer::BitmapFont::LINE_HEIGHT), 1.f, 128)
+{
+	setScore(0);
+	setLives(3);
+	setStage(1);
+	m_frameRateLabel.setText("FPS -");
+}
+
+Hud::~Hud()
+{
+}
+
+void Hud::setScore(const unsigned int score)
+{
+	m_scoreLabel.setText((TextBuilder(m_textBuffer) << "SCORE " << static_cast<size_t>(score)).text());
+}
+
+void Hud::setLives(const unsigned int lives)
+{
+	m_livesLabel.setText((TextBuilder(m_textBuffer) << "LIVES " << static_cast<size_t>(lives)).text());
+}
+
+void Hud::setStage(const unsigned int stage)
+{
+	// right aligned to the level's edge
+	m_stageLabel.setText((TextBuilder(m_textBuffer) << "STAGE " << static_cast<size_t>(stage)).text());
+	m_stageLabel.setPosition(glm::vec2(m_screenSize.x - SIDE_MARGIN - m_stageLabel.size().x, m_stageLabel.position().y));
+}
+
+void Hud::update(const uint64_t delta)
+{
+	m_frameRateTime += delta;
+	++m_frameRateFramesCount;
+	if (m_frameRateTime < FRAME_RATE_PERIOD)
+	{
+		return;
+	}
+
+	const size_t framesPerSecond = static_cast<size_t>(m_frameRateFramesCount * 1e9 / m_frameRateTime + 0.5);
+	const size_t frameTimeTenths = static_cast<size_t>(m_frameRateTime * 1e-5 / m_frameRateFramesCount + 0.5);
+	m_frameRateLabel.setText((TextBuilder(m_textBuffer) << "FPS " << framesPerSecond << " ").appendTenths(frameTimeTenths).text());
+	m_frameRateTime = 0;
+	m_frameRateFramesCount = 0;
+}
+
+void Hud::setRenderStats(const Renderer::RenderStats::Counters& counters)
+{
+	using ECounter = Renderer::RenderStats::ECounter;
+	auto counter = [&counters](const ECounter eCounter) { return counters[static_cast<size_t>(eCounter)]; };
+
+	m_renderStatsLabel.setText((TextBuilder(m_textBuffer)
+								<< "DRAWS " << counter(ECounter::DrawCalls) << " VERTS " << counter(ECounter::Vertices)
+								<< "\nPROGRAMS " << counter(ECounter::ProgramSwitches) << " TEX " << counter(ECounter::TextureBinds) << " VAO " << counter(ECounter::VertexArrayBinds)
+								<< "\nUPLOADS " << counter(ECounter::BufferUploads) << " " << counter(ECounter::BufferUploadBytes) << "B"
+								<< " UNIFORMS " << counter(ECounter::UniformUpdates)).text());
+}
+
+void Hud::submit(Renderer::RenderQueue& renderQueue, const glm::vec2& viewOrigin) const
+{
+	m_scoreLabel.submit(renderQueue, Renderer::ERenderLayer::HUD, viewOrigin);
+	m_livesLabel.submit(renderQueue, Renderer::ERenderLayer::HUD, viewOrigin);
+	m_stageLabel.submit(renderQueue, Renderer::ERenderLayer::HUD, viewOrigin);
+	if (m_isOverlayVisible)
+	{
+		m_frameRateLabel.submit(renderQueue, Renderer::ERenderLayer::HUD, viewOrigin);
+		m_renderStatsLabel.submit(renderQueue, Renderer::ERenderLayer::HUD, viewOrigin);
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../Renderer/TextLabel.hpp"
+#include "../Renderer/RenderStats.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace Renderer {
+	class BitmapFont;
+	class ShaderProgram;
+	class RenderQueue;
+}
+
+// Score, lives and stage along the top of the screen and the debug overlay
+// (frame rate and render counters) toggled with F3. Labels are rebuilt only
+// when their values change and numbers are formatted into a fixed buffer,
+// so a frame with an unchanged HUD allocates nothing.
+class Hud {
+public:
+	// screenSize is the native resolution, the HUD is laid out in it
+	Hud(std::shared_ptr<Renderer::ShaderProgram> pShaderProgram, const glm::vec2& screenSize);
+	~Hud();
+
+	void setScore(const unsigned int score);
+	void setLives(const unsigned int lives);
+	void setStage(const unsigned int stage);
+
+	void setOverlayVisible(const bool isVisible) { m_isOverlayVisible = isVisible; }
+	bool isOverlayVisible() const { return m_isOverlayVisible; }
+	// counts the frame towards the frame rate shown by the overlay
+	void update(const uint64_t delta);
+	void setRenderStats(const Renderer::RenderStats::Counters& counters);
+
+	// viewOrigin keeps the HUD in place on screen while the camera moves
+	void submit(Renderer::RenderQueue& renderQueue, const glm::vec2& viewOrigin) const;
+
+private:
+	// appends to m_textBuffer without allocating
+	class TextBuilder;
+
+	std::shared_ptr<Renderer::BitmapFont> m_pFont;
+	glm::vec2 m_screenSize;
+	Renderer::TextLabel m_scoreLabel;
+	Renderer::TextLabel m_livesLabel;
+	Renderer::TextLabel m_stageLabel;
+	Renderer::TextLabel m_frameRateLabel;
+	Renderer::TextLabel m_renderStatsLabel;
+	bool m_isOverlayVisible = false;
+	uint64_t m_frameRateTime = 0;
+	unsigned int m_frameRateFramesCount = 0;
+	std::array<char, 128> m_textBuffer;
+};
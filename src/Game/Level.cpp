@@ -0,0 +1,226 @@
+#include "Level.hpp"
+
+#include "../Renderer/Texture2D.hpp"
+#include "../Renderer/ShaderProgram.hpp"
+#include "../Renderer/TileMapRenderer.hpp"
+#include "../Renderer/RenderQueue.hpp"
+#include "../Renderer/AnimationClipTable.hpp"
+#include "../Renderer/Camera.hpp"
+#include "../Renderer/RenderSnapshot.hpp"
+
+#include <iostream>
+
+namespace {
+	// indexed by the mask of remaining brick quarters
+	const char* const BRICK_SUBTEXTURES[] = {
+		"nothing",
+		"topLeftBlock",
+		"topRightBlock",
+		"topBlock",
+		"bottomLeftBlock",
+		"leftBlock",
+		"topRightBottomLeftBlock",
+		"topBottomLeftBlock",
+		"bottomRightBlock",
+		"topLeftBottomRightBlock",
+		"rightBlock",
+		"topBottomRightBlock",
+		"bottomBlock",
+		"topLeftBottomBlock",
+		"topRightBottomBlock",
+		"block"
+	};
+}
+
+Level::Level(const std::vector<std::string>& description, const unsigned int blockSize)
+{
+	if (description.empty())
+	{
+		std::cerr << "Empty level description" << std::endl;
+		return;
+	}
+
+	m_height = static_cast<unsigned int>(description.size()) * blockSize;
+	m_width = static_cast<unsigned int>(description.front().size()) * blockSize;
+	m_tiles.resize(static_cast<size_t>(m_width) * m_height);
+
+	for (unsigned int y = 0; y < m_height; ++y)
+	{
+		const std::string& row = description[y / blockSize];
+		for (unsigned int x = 0; x < m_width; ++x)
+		{
+			const size_t column = x / blockSize;
+			const ETileType type = column < row.size() ? static_cast<ETileType>(row[column]) : ETileType::Empty;
+
+			Tile& tile = m_tiles[static_cast<size_t>(y) * m_width + x];
+			switch (type)
+			{
+			case ETileType::Brick:
+			case ETileType::Steel:
+			case ETileType::Water:
+			case ETileType::Ice:
+			case ETileType::Forest:
+				tile.type = type;
+				break;
+			default:
+				tile.type = ETileType::Empty;
+				break;
+			}
+			tile.bricks = tile.type == ETileType::Brick ? EBrickQuarter::All : 0;
+		}
+	}
+}
+
+Level::~Level()
+{
+}
+
+bool Level::init(std::shared_ptr<Renderer::Texture2D> pTextureAtlas,
+				 std::shared_ptr<Renderer::ShaderProgram> pShaderProgram,
+				 Renderer::AnimationClipTable& animationClipTable,
+				 const float tileSize,
+				 const glm::vec2& position)
+{
+	if (!pTextureAtlas || !pShaderProgram)
+	{
+		std::cerr << "Can't init the level without a texture atlas and a shader" << std::endl;
+		return false;
+	}
+
+	m_pTextureAtlas = std::move(pTextureAtlas);
+	m_tileSize = tileSize;
+	m_position = position;
+	m_waterClipID = animationClipTable.addClip(*m_pTextureAtlas, {
+		{ "water1", static_cast<uint64_t>(5e8) },
+		{ "water2", static_cast<uint64_t>(5e8) },
+		{ "water3", static_cast<uint64_t>(5e8) }
+	});
+
+	m_pTileMapRenderer = std::make_unique<Renderer::TileMapRenderer>(m_pTextureAtlas,
+																	 std::move(pShaderProgram),
+																	 m_width,
+																	 m_height,
+																	 tileSize,
+																	 position,
+																	 EMapLayer::LayersCount);
+	for (unsigned int y = 0; y < m_height; ++y)
+	{
+		for (unsigned int x = 0; x < m_width; ++x)
+		{
+			updateTile(x, y, m_tiles[static_cast<size_t>(y) * m_width + x]);
+		}
+	}
+	return true;
+}
+
+void Level::updateTile(const unsigned int x, const unsigned int y, const Tile& tile)
+{
+	m_pTileMapRenderer->clearTile(EMapLayer::Ground, x, y);
+	m_pTileMapRenderer->clearTile(EMapLayer::ForestLayer, x, y);
+
+	switch (tile.type)
+	{
+	case ETileType::Brick:
+		m_pTileMapRenderer->setTile(EMapLayer::Ground, x, y, m_pTextureAtlas->getSubTexture(BRICK_SUBTEXTURES[tile.bricks]));
+		break;
+	case ETileType::Steel:
+		m_pTileMapRenderer->setTile(EMapLayer::Ground, x, y, m_pTextureAtlas->getSubTexture("rock"));
+		break;
+	case ETileType::Water:
+		if (m_waterClipID >= 0)
+		{
+			m_pTileMapRenderer->setAnimatedTile(EMapLayer::Ground, x, y, m_waterClipID);
+		}
+		else
+		{
+			m_pTileMapRenderer->setTile(EMapLayer::Ground, x, y, m_pTextureAtlas->getSubTexture("water1"));
+		}
+		break;
+	case ETileType::Ice:
+		m_pTileMapRenderer->setTile(EMapLayer::Ground, x, y, m_pTextureAtlas->getSubTexture("ice"));
+		break;
+	case ETileType::Forest:
+		m_pTileMapRenderer->setTile(EMapLayer::ForestLayer, x, y, m_pTextureAtlas->getSubTexture("leaf"));
+		break;
+	case ETileType::Empty:
+		break;
+	}
+}
+
+void Level::destroyBrick(const unsigned int x, const unsigned int y, const uint8_t quarters)
+{
+	if (x >= m_width || y >= m_height)
+	{
+		return;
+	}
+
+	Tile& tile = m_tiles[static_cast<size_t>(y) * m_width + x];
+	if (tile.type != ETileType::Brick || !(tile.bricks & quarters))
+	{
+		return;
+	}
+
+	tile.bricks &= ~quarters;
+	if (!tile.bricks)
+	{
+		tile.type = ETileType::Empty;
+	}
+	m_tileEdits.push_back(Renderer::TileEdit{ static_cast<uint16_t>(x), static_cast<uint16_t>(y), tile.bricks });
+}
+
+void Level::takeTileEdits(std::vector<Renderer::TileEdit>& tileEdits)
+{
+	tileEdits.insert(tileEdits.end(), m_tileEdits.begin(), m_tileEdits.end());
+	m_tileEdits.clear();
+}
+
+void Level::applyTileEdits(const std::vector<Renderer::TileEdit>& tileEdits, const uint64_t appliedSnapshotIndex)
+{
+	// only bricks change, so an edit is all the map needs to know
+	for (const Renderer::TileEdit& tileEdit : tileEdits)
+	{
+		if (tileEdit.snapshotIndex <= appliedSnapshotIndex)
+		{
+			continue;
+		}
+		Tile tile;
+		tile.type = tileEdit.bricks ? ETileType::Brick : ETileType::Empty;
+		tile.bricks = tileEdit.bricks;
+		updateTile(tileEdit.x, tileEdit.y, tile);
+	}
+}
+
+Level::ETileType Level::tileType(const unsigned int x, const unsigned int y) const
+{
+	if (x >= m_width || y >= m_height)
+	{
+		return ETileType::Empty;
+	}
+	return m_tiles[static_cast<size_t>(y) * m_width + x].type;
+}
+
+size_t Level::rebuiltChunksCount() const
+{
+	return m_pTileMapRenderer ? m_pTileMapRenderer->rebuiltChunksCount() : 0;
+}
+
+Renderer::ViewRect Level::bounds() const
+{
+	return Renderer::ViewRect{ m_position, m_position + m_tileSize * glm::vec2(m_width, m_height) };
+}
+
+void Level::renderGround(const Renderer::ViewRect& view)
+{
+	m_pTileMapRenderer->render(EMapLayer::Ground, view);
+}
+
+void Level::renderForest(const Renderer::ViewRect& view)
+{
+	m_pTileMapRenderer->render(EMapLayer::ForestLayer, view);
+}
+
+void Level::submit(Renderer::RenderQueue& renderQueue, const Renderer::AnimationClipTable& animationClipTable, const float time, const Renderer::ViewRect& view) const
+{
+	m_pTileMapRenderer->submit(renderQueue, EMapLayer::Ground, Renderer::ERenderLayer::Ground, animationClipTable, time, view);
+	m_pTileMapRenderer->submit(renderQueue, EMapLayer::ForestLayer, Renderer::ERenderLayer::Forest, animationClipTable, time, view);
+}
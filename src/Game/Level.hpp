@@ -0,0 +1,95 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Renderer {
+	class Texture2D;
+	class ShaderProgram;
+	class TileMapRenderer;
+	class AnimationClipTable;
+	class RenderQueue;
+	struct ViewRect;
+	struct TileEdit;
+}
+
+class Level {
+public:
+	enum class ETileType : char {
+		Empty = '.',
+		Brick = 'B',
+		Steel = 'S',
+		Water = 'W',
+		Ice = 'I',
+		Forest = 'F'
+	};
+
+	// quarters of a brick tile, combined into a mask
+	enum EBrickQuarter : uint8_t {
+		TopLeft = 1,
+		TopRight = 2,
+		BottomLeft = 4,
+		BottomRight = 8,
+		All = 15
+	};
+
+	// every character of the description is a block of blockSize x blockSize tiles
+	Level(const std::vector<std::string>& description, const unsigned int blockSize = 2);
+	~Level();
+
+	bool init(std::shared_ptr<Renderer::Texture2D> pTextureAtlas,
+			  std::shared_ptr<Renderer::ShaderProgram> pShaderProgram,
+			  Renderer::AnimationClipTable& animationClipTable,
+			  const float tileSize,
+			  const glm::vec2& position);
+
+	// update side: changes the tile and records the edit for the map that draws it
+	void destroyBrick(const unsigned int x, const unsigned int y, const uint8_t quarters);
+	ETileType tileType(const unsigned int x, const unsigned int y) const;
+	// update side: appends the edits since the last call
+	void takeTileEdits(std::vector<Renderer::TileEdit>& tileEdits);
+	// on the side that draws the map: applies the edits of snapshots after
+	// appliedSnapshotIndex, rebuilding only the chunks they touch
+	void applyTileEdits(const std::vector<Renderer::TileEdit>& tileEdits, const uint64_t appliedSnapshotIndex);
+
+	// only the chunks overlapping view
+	void renderGround(const Renderer::ViewRect& view);
+	void renderForest(const Renderer::ViewRect& view);
+	// both layers as sprite commands, ground to ERenderLayer::Ground and forest to ERenderLayer::Forest
+	void submit(Renderer::RenderQueue& renderQueue, const Renderer::AnimationClipTable& animationClipTable, const float time, const Renderer::ViewRect& view) const;
+
+	unsigned int width() const { return m_width; }
+	unsigned int height() const { return m_height; }
+	// map chunks rebuilt since init, counting the first upload of every chunk
+	size_t rebuiltChunksCount() const;
+	// the map in world units, valid after init
+	Renderer::ViewRect bounds() const;
+
+private:
+	enum EMapLayer : unsigned int {
+		Ground,
+		ForestLayer,
+		LayersCount
+	};
+
+	struct Tile {
+		ETileType type = ETileType::Empty;
+		uint8_t bricks = 0;
+	};
+
+	void updateTile(const unsigned int x, const unsigned int y, const Tile& tile);
+
+	unsigned int m_width = 0;
+	unsigned int m_height = 0;
+	float m_tileSize = 0.f;
+	glm::vec2 m_position = glm::vec2(0.f);
+	std::vector<Tile> m_tiles;
+	std::vector<Renderer::TileEdit> m_tileEdits;
+	std::shared_ptr<Renderer::Texture2D> m_pTextureAtlas;
+	int m_waterClipID = -1;
+	std::unique_ptr<Renderer::TileMapRenderer> m_pTileMapRenderer;
+};
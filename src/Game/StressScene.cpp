@@ -0,0 +1,494 @@
+#include "StressScene.hpp"
+
+#include "../Resources/ResourceManager.hpp"
+#include "../Renderer/Sprite.hpp"
+#include "../Renderer/AnimatedSprite.hpp"
+#include "../Renderer/SpriteQuad.hpp"
+#include "../Renderer/SpriteBatch.hpp"
+#include "../Renderer/StreamBuffer.hpp"
+#include "../Renderer/RenderQueue.hpp"
+#include "../Renderer/CommandRecorder.hpp"
+#include "../Renderer/Camera.hpp"
+#include "../Renderer/VisibilityGrid.hpp"
+#include "../Renderer/TileMapRenderer.hpp"
+#include "../Renderer/ParticleSystem.hpp"
+#include "../Renderer/ShaderProgram.hpp"
+#include "../Renderer/AnimationClipTable.hpp"
+#include "../Renderer/RenderSnapshot.hpp"
+#include "../Renderer/RenderStats.hpp"
+#include "Level.hpp"
+
+#include <glad/glad.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace {
+	const char* const STRESS_TEXTURE_NAME = "DefaultTextureAtlas";
+	const char* const STRESS_SHADER_NAME = "SpriteShader";
+	const float STRESS_SPRITE_SIZE = 16.f;
+	const char* const STRESS_TILE_SHADER_NAME = "TileShader";
+	// the culling world is this many screens across and up
+	const float CULLING_WORLD_SCREENS = 8.f;
+	const unsigned int CULLING_MAP_TILES = 256;
+	const float CULLING_TILE_SIZE = 8.f;
+	// blocks of 2x2 tiles, so a 64x64 tile map of 8x8 chunks, 128 over both layers
+	const unsigned int BRICK_LEVEL_BLOCKS = 32;
+
+	std::vector<std::unique_ptr<Renderer::Sprite>> createSprites(const size_t spritesCount, const glm::vec2& windowSize)
+	{
+		const std::vector<std::string> subTexturesNames = { "block", "wall", "water1", "leaf", "ice" };
+
+		auto pTexture = ResourceManager::getTexture(STRESS_TEXTURE_NAME);
+		auto pShaderProgram = ResourceManager::getShaderProgram(STRESS_SHADER_NAME);
+
+		std::mt19937 generator(42);
+		std::uniform_real_distribution<float> positionX(0.f, windowSize.x - STRESS_SPRITE_SIZE);
+		std::uniform_real_distribution<float> positionY(0.f, windowSize.y - STRESS_SPRITE_SIZE);
+
+		std::vector<std::unique_ptr<Renderer::Sprite>> sprites;
+		sprites.reserve(spritesCount);
+		for (size_t i = 0; i < spritesCount; ++i)
+		{
+			sprites.emplace_back(std::make_unique<Renderer::Sprite>(pTexture,
+																	subTexturesNames[i % subTexturesNames.size()],
+																	pShaderProgram,
+																	glm::vec2(positionX(generator), positionY(generator)),
+																	glm::vec2(STRESS_SPRITE_SIZE)));
+		}
+		return sprites;
+	}
+
+	template<class RenderFunction>
+	double measureFrames(const unsigned int framesCount, RenderFunction renderFrame)
+	{
+		// warm up: first frames pay for shader and buffer uploads
+		renderFrame();
+		glFinish();
+
+		auto startTime = std::chrono::high_resolution_clock::now();
+		for (unsigned int frame = 0; frame < framesCount; ++frame)
+		{
+			Renderer::GLStateCache::beginFrame();
+			glClear(GL_COLOR_BUFFER_BIT);
+			renderFrame();
+		}
+		glFinish();
+		auto endTime = std::chrono::high_resolution_clock::now();
+
+		return std::chrono::duration<double, std::milli>(endTime - startTime).count() / framesCount;
+	}
+}
+
+StressScene::StressScene(const glm::vec2& windowSize) :
+	m_windowSize(windowSize)
+{
+}
+
+void StressScene::run(const std::vector<size_t>& spritesCounts, const unsigned int framesCount)
+{
+	if (!ResourceManager::getTexture(STRESS_TEXTURE_NAME) || !ResourceManager::getShaderProgram(STRESS_SHADER_NAME))
+	{
+		std::cerr << "Stress scene requires the game resources to be loaded" << std::endl;
+		return;
+	}
+
+	std::cout << "Stress scene: " << framesCount << " frames per run" << std::endl;
+	std::cout << "Per-sprite memory: Sprite " << sizeof(Renderer::Sprite) << " bytes"
+			  << ", AnimatedSprite " << sizeof(Renderer::AnimatedSprite) << " bytes"
+			  << " (instance record " << sizeof(Renderer::SpriteInstance) << " bytes), 0 GL objects"
+			  << "; shared quad " << Renderer::SpriteQuad::memoryUsage() << " bytes"
+			  << "; batched vertices " << Renderer::SpriteBatch::spriteVerticesSize() << " bytes" << std::endl;
+	std::cout << std::setw(10) << "sprites"
+			  << std::setw(18) << "immediate ms"
+			  << std::setw(16) << "batched ms"
+			  << std::setw(14) << "draw calls"
+			  << std::setw(10) << "speedup"
+			  << std::setw(26) << "immediate binds issued"
+			  << std::setw(10) << "elided"
+			  << std::setw(16) << "fence wait ms" << std::endl;
+
+	for (const size_t spritesCount : spritesCounts)
+	{
+		Renderer::GLStateCache::Counters stateCounters;
+		const double immediateTime = renderImmediate(spritesCount, framesCount, stateCounters);
+
+		size_t drawCallsCount = 0;
+		double fenceWaitTime = 0.0;
+		const double batchedTime = renderBatched(spritesCount, framesCount, drawCallsCount, fenceWaitTime);
+
+		std::cout << std::setw(10) << spritesCount
+				  << std::fixed << std::setprecision(3)
+				  << std::setw(18) << immediateTime
+				  << std::setw(16) << batchedTime
+				  << std::setw(14) << drawCallsCount
+				  << std::setw(9) << std::setprecision(1) << immediateTime / batchedTime << "x"
+				  << std::setw(26) << stateCounters.issuedTotal()
+				  << std::setw(10) << stateCounters.elidedTotal()
+				  << std::setw(16) << std::setprecision(3) << fenceWaitTime
+				  << std::defaultfloat << std::endl;
+	}
+
+	measureRenderQueue(spritesCounts.back(), framesCount);
+	measureRecording(spritesCounts.back(), framesCount);
+	measureCulling(spritesCounts.back(), framesCount);
+	measureParticles(spritesCounts.back(), framesCount);
+	measureBrickDestruction(framesCount);
+}
+
+void StressScene::measureRenderQueue(const size_t submissionsCount, const unsigned int framesCount) const
+{
+	auto pTexture = ResourceManager::getTexture(STRESS_TEXTURE_NAME);
+	auto pShaderProgram = ResourceManager::getShaderProgram(STRESS_SHADER_NAME);
+
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<int> layers(static_cast<int>(Renderer::ERenderLayer::Ground), static_cast<int>(Renderer::ERenderLayer::HUD));
+	std::uniform_real_distribution<float> depths(-1.f, 1.f);
+
+	std::vector<std::pair<Renderer::ERenderLayer, float>> submissions(submissionsCount);
+	for (auto& submission : submissions)
+	{
+		submission = { static_cast<Renderer::ERenderLayer>(layers(generator)), depths(generator) };
+	}
+
+	const Renderer::SpriteInstance instance{ glm::vec2(0.f), glm::vec2(STRESS_SPRITE_SIZE), 0.f, pTexture->getSubTexture("block") };
+	Renderer::RenderQueue renderQueue(submissionsCount);
+
+	double submitTime = 0.0;
+	double sortTime = 0.0;
+	for (unsigned int frame = 0; frame < framesCount; ++frame)
+	{
+		renderQueue.clear();
+
+		auto startTime = std::chrono::high_resolution_clock::now();
+		for (const auto& submission : submissions)
+		{
+			renderQueue.submit(submission.first, submission.second, *pShaderProgram, *pTexture, instance);
+		}
+		auto submittedTime = std::chrono::high_resolution_clock::now();
+		renderQueue.sort();
+		auto sortedTime = std::chrono::high_resolution_clock::now();
+
+		submitTime += std::chrono::duration<double, std::milli>(submittedTime - startTime).count();
+		sortTime += std::chrono::duration<double, std::milli>(sortedTime - submittedTime).count();
+	}
+
+	std::cout << "Render queue: " << submissionsCount << " submissions, "
+			  << std::fixed << std::setprecision(3)
+			  << "submit " << submitTime / framesCount << " ms, "
+			  << "sort " << sortTime / framesCount << " ms per frame"
+			  << std::defaultfloat << std::endl;
+}
+
+void StressScene::measureRecording(const size_t spritesCount, const unsigned int framesCount) const
+{
+	auto sprites = createSprites(spritesCount, m_windowSize);
+	auto recordRange = [&sprites](Renderer::RenderQueue& commandBuffer, const size_t first, const size_t last) {
+		for (size_t i = first; i < last; ++i)
+		{
+			sprites[i]->submit(commandBuffer, static_cast<Renderer::ERenderLayer>(i % 3), static_cast<float>(i % 7));
+		}
+	};
+
+	std::cout << "Command recording: " << spritesCount << " sprites, "
+			  << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+	std::cout << std::setw(10) << "threads"
+			  << std::setw(14) << "record ms"
+			  << std::setw(12) << "sort ms"
+			  << std::setw(10) << "speedup" << std::endl;
+
+	double singleThreadTime = 0.0;
+	for (const unsigned int threadsCount : { 1u, 2u, 4u, 8u })
+	{
+		Renderer::CommandRecorder recorder(threadsCount);
+		Renderer::RenderQueue renderQueue(spritesCount);
+
+		// warm up: the first frame grows the command buffers
+		recorder.record(renderQueue, spritesCount, recordRange);
+
+		double recordTime = 0.0;
+		double sortTime = 0.0;
+		for (unsigned int frame = 0; frame < framesCount; ++frame)
+		{
+			renderQueue.clear();
+
+			auto startTime = std::chrono::high_resolution_clock::now();
+			recorder.record(renderQueue, spritesCount, recordRange);
+			auto recordedTime = std::chrono::high_resolution_clock::now();
+			renderQueue.sort();
+			auto sortedTime = std::chrono::high_resolution_clock::now();
+
+			recordTime += std::chrono::duration<double, std::milli>(recordedTime - startTime).count();
+			sortTime += std::chrono::duration<double, std::milli>(sortedTime - recordedTime).count();
+		}
+		recordTime /= framesCount;
+		sortTime /= framesCount;
+		if (threadsCount == 1)
+		{
+			singleThreadTime = recordTime;
+		}
+
+		std::cout << std::setw(10) << threadsCount
+				  << std::fixed << std::setprecision(3)
+				  << std::setw(14) << recordTime
+				  << std::setw(12) << sortTime
+				  << std::setw(9) << std::setprecision(1) << singleThreadTime / recordTime << "x"
+				  << std::defaultfloat << std::endl;
+	}
+}
+
+void StressScene::measureCulling(const size_t spritesCount, const unsigned int framesCount) const
+{
+	const glm::vec2 worldSize = CULLING_WORLD_SCREENS * m_windowSize;
+	const Renderer::ViewRect worldRect{ glm::vec2(0.f), worldSize };
+	auto sprites = createSprites(spritesCount, worldSize);
+
+	Renderer::VisibilityGrid visibilityGrid(worldRect, 64.f);
+	for (size_t i = 0; i < sprites.size(); ++i)
+	{
+		visibilityGrid.insert(static_cast<uint32_t>(i), sprites[i]->position(), sprites[i]->size());
+	}
+
+	// the camera pans across the middle of the world, one pixel per frame
+	Renderer::Camera camera(m_windowSize, 0.5f * (worldSize - m_windowSize));
+	camera.setBounds(worldRect);
+	Renderer::RenderQueue renderQueue(spritesCount);
+	std::vector<uint32_t> visibleSprites;
+	visibleSprites.reserve(spritesCount);
+
+	double allTime = 0.0;
+	double queryTime = 0.0;
+	double culledTime = 0.0;
+	size_t visibleCount = 0;
+	for (unsigned int frame = 0; frame < framesCount; ++frame)
+	{
+		camera.move(glm::vec2(1.f, 0.f));
+
+		renderQueue.clear();
+		auto startTime = std::chrono::high_resolution_clock::now();
+		for (const auto& pSprite : sprites)
+		{
+			pSprite->submit(renderQueue, Renderer::ERenderLayer::Tanks);
+		}
+		renderQueue.sort();
+		auto allSubmittedTime = std::chrono::high_resolution_clock::now();
+
+		renderQueue.clear();
+		visibleSprites.clear();
+		visibilityGrid.query(camera.viewRect(), visibleSprites);
+		auto queriedTime = std::chrono::high_resolution_clock::now();
+		for (const uint32_t id : visibleSprites)
+		{
+			sprites[id]->submit(renderQueue, Renderer::ERenderLayer::Tanks);
+		}
+		renderQueue.sort();
+		auto culledSubmittedTime = std::chrono::high_resolution_clock::now();
+
+		allTime += std::chrono::duration<double, std::milli>(allSubmittedTime - startTime).count();
+		queryTime += std::chrono::duration<double, std::milli>(queriedTime - allSubmittedTime).count();
+		culledTime += std::chrono::duration<double, std::milli>(culledSubmittedTime - allSubmittedTime).count();
+		visibleCount += visibleSprites.size();
+	}
+
+	std::cout << "Culling: " << spritesCount << " sprites over " << static_cast<int>(CULLING_WORLD_SCREENS * CULLING_WORLD_SCREENS) << " screens, "
+			  << std::fixed << std::setprecision(3)
+			  << "submit and sort all " << allTime / framesCount << " ms, "
+			  << "visible only " << culledTime / framesCount << " ms (grid query " << queryTime / framesCount << " ms, "
+			  << visibleCount / framesCount << " visible) per frame"
+			  << std::defaultfloat << std::endl;
+
+	auto pTexture = ResourceManager::getTexture(STRESS_TEXTURE_NAME);
+	auto pTileShaderProgram = ResourceManager::getShaderProgram(STRESS_TILE_SHADER_NAME);
+	if (!pTileShaderProgram)
+	{
+		return;
+	}
+
+	Renderer::TileMapRenderer tileMap(pTexture, pTileShaderProgram, CULLING_MAP_TILES, CULLING_MAP_TILES, CULLING_TILE_SIZE);
+	const auto& subTexture = pTexture->getSubTexture("block");
+	for (unsigned int y = 0; y < CULLING_MAP_TILES; ++y)
+	{
+		for (unsigned int x = 0; x < CULLING_MAP_TILES; ++x)
+		{
+			tileMap.setTile(0, x, y, subTexture);
+		}
+	}
+
+	const Renderer::ViewRect mapView{ glm::vec2(0.f), glm::vec2(CULLING_MAP_TILES * CULLING_TILE_SIZE) };
+	const double wholeMapTime = measureFrames(framesCount, [&tileMap, &mapView]() {
+		tileMap.render(0, mapView);
+	});
+	const size_t wholeMapChunksCount = tileMap.drawnChunksCount();
+
+	const Renderer::ViewRect cameraView = Renderer::Camera(m_windowSize, 0.5f * (mapView.max - m_windowSize)).viewRect();
+	const double cameraViewTime = measureFrames(framesCount, [&tileMap, &cameraView]() {
+		tileMap.render(0, cameraView);
+	});
+
+	std::cout << "Tile map " << CULLING_MAP_TILES << "x" << CULLING_MAP_TILES << ": "
+			  << std::fixed << std::setprecision(3)
+			  << "whole map " << wholeMapTime << " ms (" << wholeMapChunksCount << " chunks), "
+			  << "camera view " << cameraViewTime << " ms (" << tileMap.drawnChunksCount() << " chunks) per frame"
+			  << std::defaultfloat << std::endl;
+}
+
+double StressScene::renderImmediate(const size_t spritesCount, const unsigned int framesCount, Renderer::GLStateCache::Counters& stateCounters) const
+{
+	auto sprites = createSprites(spritesCount, m_windowSize);
+
+	const double frameTime = measureFrames(framesCount, [&sprites]() {
+		for (const auto& pSprite : sprites)
+		{
+			pSprite->render();
+		}
+	});
+
+	stateCounters = Renderer::GLStateCache::frameCounters();
+	return frameTime;
+}
+
+void StressScene::measureParticles(const size_t particlesCount, const unsigned int framesCount) const
+{
+	auto pShaderProgram = ResourceManager::getShaderProgram(STRESS_SHADER_NAME);
+	Renderer::ParticleSystem particles(pShaderProgram, particlesCount);
+	// long enough that most survive a frame, short enough that some die every frame
+	const Renderer::ParticleSystem::Emitter emitter = { 64, 8.f, 64.f, 0.5f, 2.f, 2.f, 1.f, Renderer::ParticleSystem::EPalette::Fire };
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> positionX(0.f, m_windowSize.x);
+	std::uniform_real_distribution<float> positionY(0.f, m_windowSize.y);
+	auto refill = [&]() {
+		while (particles.size() < particles.capacity())
+		{
+			particles.emit(emitter, glm::vec2(positionX(generator), positionY(generator)));
+		}
+	};
+
+	const uint64_t frameDuration = 1000000000 / 60;
+	Renderer::RenderQueue renderQueue(particlesCount);
+	double updateTime = 0.0;
+	double submitTime = 0.0;
+	size_t diedCount = 0;
+	for (unsigned int frame = 0; frame < framesCount; ++frame)
+	{
+		refill();
+		auto startTime = std::chrono::high_resolution_clock::now();
+		particles.update(frameDuration);
+		auto updatedTime = std::chrono::high_resolution_clock::now();
+		diedCount += particles.capacity() - particles.size();
+
+		renderQueue.clear();
+		auto submitStartTime = std::chrono::high_resolution_clock::now();
+		particles.submit(renderQueue, Renderer::ERenderLayer::Bullets);
+		renderQueue.sort();
+		auto submittedTime = std::chrono::high_resolution_clock::now();
+
+		updateTime += std::chrono::duration<double, std::milli>(updatedTime - startTime).count();
+		submitTime += std::chrono::duration<double, std::milli>(submittedTime - submitStartTime).count();
+	}
+
+	Renderer::StreamBuffer streamBuffer(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(particlesCount * Renderer::SpriteBatch::spriteVerticesSize()));
+	Renderer::SpriteBatch spriteBatch(streamBuffer, particlesCount);
+	const double drawTime = measureFrames(framesCount, [&]() {
+		refill();
+		particles.update(frameDuration);
+		spriteBatch.begin();
+		particles.submit(spriteBatch);
+		spriteBatch.end();
+		streamBuffer.endFrame();
+	});
+
+	std::cout << "Particles: " << particlesCount << " live, " << diedCount / framesCount << " dying per frame, "
+			  << std::fixed << std::setprecision(3)
+			  << "update " << updateTime / framesCount << " ms, "
+			  << "submit and sort " << submitTime / framesCount << " ms, "
+			  << "update and batched draw " << drawTime << " ms in " << spriteBatch.drawCallsCount() << " draw calls per frame"
+			  << std::defaultfloat << std::endl;
+}
+
+void StressScene::measureBrickDestruction(const unsigned int framesCount) const
+{
+	auto pTexture = ResourceManager::getTexture(STRESS_TEXTURE_NAME);
+	auto pTileShaderProgram = ResourceManager::getShaderProgram(STRESS_TILE_SHADER_NAME);
+	if (!pTileShaderProgram)
+	{
+		return;
+	}
+
+	Level level(std::vector<std::string>(BRICK_LEVEL_BLOCKS, std::string(BRICK_LEVEL_BLOCKS, 'B')));
+	Renderer::AnimationClipTable animationClipTable;
+	if (!level.init(pTexture, pTileShaderProgram, animationClipTable, CULLING_TILE_SIZE, glm::vec2(0.f)))
+	{
+		return;
+	}
+
+	const Renderer::ViewRect view = level.bounds();
+	auto renderLevel = [&level, &view]() {
+		level.renderGround(view);
+		level.renderForest(view);
+	};
+	// the first frame uploads every chunk
+	renderLevel();
+	const size_t loadedChunksCount = level.rebuiltChunksCount();
+	Renderer::RenderStats::endFrame();
+	const double unchangedTime = measureFrames(framesCount, renderLevel);
+	Renderer::RenderStats::endFrame();
+	const size_t unchangedRebuiltCount = level.rebuiltChunksCount() - loadedChunksCount;
+	const size_t unchangedUploadBytes = Renderer::RenderStats::lastFrame()[static_cast<size_t>(Renderer::RenderStats::ECounter::BufferUploadBytes)];
+
+	// the way Game passes a hit from the update to the render side
+	level.destroyBrick(level.width() / 2, level.height() / 2, Level::EBrickQuarter::All);
+	std::vector<Renderer::TileEdit> tileEdits;
+	level.takeTileEdits(tileEdits);
+	for (Renderer::TileEdit& tileEdit : tileEdits)
+	{
+		tileEdit.snapshotIndex = 1;
+	}
+	const size_t editedChunksCount = level.rebuiltChunksCount();
+	auto startTime = std::chrono::high_resolution_clock::now();
+	level.applyTileEdits(tileEdits, 0);
+	Renderer::GLStateCache::beginFrame();
+	glClear(GL_COLOR_BUFFER_BIT);
+	renderLevel();
+	glFinish();
+	const double destroyedTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+	Renderer::RenderStats::endFrame();
+	const size_t destroyedUploadBytes = Renderer::RenderStats::lastFrame()[static_cast<size_t>(Renderer::RenderStats::ECounter::BufferUploadBytes)];
+
+	std::cout << "Level " << level.width() << "x" << level.height() << " bricks: "
+			  << std::fixed << std::setprecision(3)
+			  << "unchanged map " << unchangedTime << " ms per frame (" << unchangedRebuiltCount << " chunks rebuilt and "
+			  << unchangedUploadBytes << " bytes uploaded in " << framesCount << " frames, " << loadedChunksCount << " chunks at load), "
+			  << "frame with a destroyed brick " << destroyedTime << " ms (" << level.rebuiltChunksCount() - editedChunksCount << " chunks rebuilt, "
+			  << destroyedUploadBytes << " bytes uploaded)"
+			  << std::defaultfloat << std::endl;
+}
+
+double StressScene::renderBatched(const size_t spritesCount, const unsigned int framesCount, size_t& drawCallsCount, double& fenceWaitTime) const
+{
+	auto sprites = createSprites(spritesCount, m_windowSize);
+	// a whole frame of quads fits in one region, so waits only happen when the GPU is frames behind
+	Renderer::StreamBuffer streamBuffer(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(spritesCount * Renderer::SpriteBatch::spriteVerticesSize()));
+	Renderer::SpriteBatch spriteBatch(streamBuffer);
+
+	double totalFenceWaitTime = 0.0;
+	const double frameTime = measureFrames(framesCount, [&sprites, &spriteBatch, &streamBuffer, &totalFenceWaitTime]() {
+		spriteBatch.begin();
+		for (const auto& pSprite : sprites)
+		{
+			pSprite->submit(spriteBatch);
+		}
+		spriteBatch.end();
+		streamBuffer.endFrame();
+		totalFenceWaitTime += streamBuffer.lastFrameFenceWaitTime();
+	});
+
+	drawCallsCount = spriteBatch.drawCallsCount();
+	// includes the warm-up frame
+	fenceWaitTime = totalFenceWaitTime / (framesCount + 1);
+	return frameTime;
+}
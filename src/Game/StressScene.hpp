@@ -0,0 +1,25 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+
+#include "../Renderer/GLStateCache.hpp"
+
+#include <vector>
+
+class StressScene {
+public:
+	StressScene(const glm::vec2& windowSize);
+
+	void run(const std::vector<size_t>& spritesCounts, const unsigned int framesCount);
+
+private:
+	double renderImmediate(const size_t spritesCount, const unsigned int framesCount, Renderer::GLStateCache::Counters& stateCounters) const;
+	void measureRenderQueue(const size_t submissionsCount, const unsigned int framesCount) const;
+	void measureRecording(const size_t spritesCount, const unsigned int framesCount) const;
+	void measureCulling(const size_t spritesCount, const unsigned int framesCount) const;
+	void measureParticles(const size_t particlesCount, const unsigned int framesCount) const;
+	void measureBrickDestruction(const unsigned int framesCount) const;
+	double renderBatched(const size_t spritesCount, const unsigned int framesCount, size_t& drawCallsCount, double& fenceWaitTime) const;
+
+	glm::vec2 m_windowSize;
+};
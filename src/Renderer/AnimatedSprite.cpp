@@ -41,7 +41,7 @@ namespace Renderer {
 				m_currentAnimationTime = 0;
 				m_currentFrame = 0;
 				m_pCurrentAnimationDurations = it;
-				m_dirty = true;
+				m_instance.subTexture = m_pTexture->getSubTexture(it->second[m_currentFrame].first);
 			}
 
 		}
@@ -55,40 +55,14 @@ namespace Renderer {
 				{
 					m_currentAnimationTime -= m_pCurrentAnimationDurations->second[m_currentFrame].second;
 					m_currentFrame++;
-					m_dirty = true;
 
 					if (m_currentFrame == m_pCurrentAnimationDurations->second.size())
 					{
 						m_currentFrame = 0;
 					}
+					m_instance.subTexture = m_pTexture->getSubTexture(m_pCurrentAnimationDurations->second[m_currentFrame].first);
 				}
 			}
 		}
 
-
-		void AnimatedSprite::render() const 
-		{
-			if (m_dirty)
-			{
-				auto subTexture = m_pTexture->getSubTexture(m_pCurrentAnimationDurations->second[m_currentFrame].first);
-
-				const GLfloat textureCoords[] = {
-					// U							V
-					   subTexture.leftBottomUV.x,	subTexture.leftBottomUV.y,
-					   subTexture.leftBottomUV.x,	subTexture.rightTopUV.y,
-					   subTexture.rightTopUV.x,		subTexture.rightTopUV.y,
-
-					   subTexture.rightTopUV.x,		subTexture.rightTopUV.y,
-					   subTexture.rightTopUV.x,		subTexture.leftBottomUV.y,
-					   subTexture.leftBottomUV.x,	subTexture.leftBottomUV.y
-				};
-
-				glBindBuffer(GL_ARRAY_BUFFER, m_textureCoordsVBO);
-				glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(textureCoords), &textureCoords);
-				glBindBuffer(GL_ARRAY_BUFFER, 0);
-				m_dirty = false;
-			}
-
-			Sprite::render();
-		}
 }
\ No newline at end of file
@@ -17,7 +17,6 @@ namespace Renderer {
 		void insertState(std::string state, std::vector<std::pair<std::string, uint64_t>> subTexturesDuration);
 		void setState(const std::string newState);
 
-		void render() const override;
 		void update(const uint64_t delta);
 
 	private:
@@ -25,7 +24,6 @@ namespace Renderer {
 		size_t m_currentFrame = 0;
 		uint64_t m_currentAnimationTime = 0;
 		std::map<std::string, std::vector<std::pair<std::string, uint64_t>>>::const_iterator m_pCurrentAnimationDurations;
-		mutable bool m_dirty = false;
 	};
 
 }
\ No newline at end of file
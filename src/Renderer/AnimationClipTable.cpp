@@ -0,0 +1,88 @@
+#include "AnimationClipTable.hpp"
+
+#include <cmath>
+#include <iostream>
+
+namespace Renderer {
+
+	AnimationClipTable::AnimationClipTable() = default;
+
+	int AnimationClipTable::addClip(const Texture2D& texture, const std::vector<std::pair<std::string, uint64_t>>& frames)
+	{
+		if (frames.empty())
+		{
+			std::cerr << "Can't add an animation clip without frames" << std::endl;
+			return -1;
+		}
+		if (m_clipsCount == MAX_CLIPS || m_framesCount + frames.size() > MAX_FRAMES)
+		{
+			std::cerr << "Animation clip table is full" << std::endl;
+			return -1;
+		}
+
+		const size_t firstFrame = m_framesCount;
+		double clipDuration = 0.0;
+		for (const auto& frame : frames)
+		{
+			const Texture2D::SubTexture2D& subTexture = texture.getSubTexture(frame.first);
+			clipDuration += frame.second * 1e-9;
+
+			m_data.frameUV[m_framesCount] = glm::vec4(subTexture.leftBottomUV, subTexture.rightTopUV);
+			m_data.frameEnds[m_framesCount] = glm::vec4(static_cast<float>(clipDuration), static_cast<float>(subTexture.layer), 0.f, 0.f);
+			++m_framesCount;
+		}
+
+		m_data.clips[m_clipsCount] = glm::vec4(static_cast<float>(firstFrame), static_cast<float>(frames.size()), static_cast<float>(clipDuration), 0.f);
+		m_isDirty = true;
+		return static_cast<int>(m_clipsCount++);
+	}
+
+	Texture2D::SubTexture2D AnimationClipTable::frame(const int clipID, const float time) const
+	{
+		if (clipID < 0 || static_cast<size_t>(clipID) >= m_clipsCount)
+		{
+			return Texture2D::SubTexture2D();
+		}
+
+		// same search as vTile
+		const glm::vec4& clip = m_data.clips[clipID];
+		float clipTime = std::fmod(time, clip.z);
+		if (clipTime < 0.f)
+		{
+			clipTime += clip.z;
+		}
+		size_t frame = static_cast<size_t>(clip.x);
+		const size_t lastFrame = frame + static_cast<size_t>(clip.y) - 1;
+		while (frame < lastFrame && clipTime >= m_data.frameEnds[frame].x)
+		{
+			++frame;
+		}
+
+		const glm::vec4& frameUV = m_data.frameUV[frame];
+		return Texture2D::SubTexture2D(glm::vec2(frameUV.x, frameUV.y), glm::vec2(frameUV.z, frameUV.w), static_cast<unsigned int>(m_data.frameEnds[frame].y));
+	}
+
+	std::shared_ptr<const AnimationClipTable::Data> AnimationClipTable::data()
+	{
+		if (m_isDirty || !m_pData)
+		{
+			m_pData = std::make_shared<const Data>(m_data);
+			m_isDirty = false;
+		}
+		return m_pData;
+	}
+
+	void AnimationClipTable::upload(const std::shared_ptr<const Data>& pData)
+	{
+		if (!m_pUniformBuffer)
+		{
+			m_pUniformBuffer = std::make_unique<UniformBuffer>(sizeof(Data), BINDING_POINT);
+		}
+		if (pData && pData != m_pUploadedData)
+		{
+			m_pUniformBuffer->update(pData.get(), sizeof(Data));
+			m_pUploadedData = pData;
+		}
+	}
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "UniformBuffer.hpp"
+#include "Texture2D.hpp"
+
+namespace Renderer {
+
+	// Frame tables of looping animations, uploaded to the "AnimationClips"
+	// uniform block. Vertex shaders pick the current frame from the clip id
+	// and start time of a vertex and FrameData.time, so ambient animations
+	// need no CPU updates and no buffer uploads once registered. Clips are
+	// added on the update side, the render side uploads the copies of the
+	// table that come with the render snapshots.
+	class AnimationClipTable {
+	public:
+		static constexpr GLuint BINDING_POINT = 1;
+		static constexpr const char* BLOCK_NAME = "AnimationClips";
+		static constexpr size_t MAX_CLIPS = 32;
+		static constexpr size_t MAX_FRAMES = 128;
+
+		// std140: every array element is 16 bytes
+		struct Data {
+			glm::vec4 frameUV[MAX_FRAMES];		// left bottom uv, right top uv
+			glm::vec4 frameEnds[MAX_FRAMES];	// x: end of the frame from the clip start, seconds, y: texture layer
+			glm::vec4 clips[MAX_CLIPS];			// x: first frame, y: frames count, z: clip duration, seconds
+		};
+
+		AnimationClipTable();
+
+		AnimationClipTable(const AnimationClipTable&) = delete;
+		AnimationClipTable& operator=(const AnimationClipTable&) = delete;
+
+		// frames are sub texture names with durations in nanoseconds, like AnimatedSprite states;
+		// returns the clip id or -1 when the table is full
+		int addClip(const Texture2D& texture, const std::vector<std::pair<std::string, uint64_t>>& frames);
+		// an immutable copy of the table for the render snapshot, made again only after addClip
+		std::shared_ptr<const Data> data();
+		// render thread: uploads a copy from data() unless it was the last one
+		// uploaded, call before drawing with a shader that uses the table
+		void upload(const std::shared_ptr<const Data>& pData);
+		// the frame the vertex shader shows for the clip at time seconds after its start
+		Texture2D::SubTexture2D frame(const int clipID, const float time) const;
+
+	private:
+		Data m_data{};
+		size_t m_framesCount = 0;
+		size_t m_clipsCount = 0;
+		bool m_isDirty = false;
+		// the last copy handed out by data()
+		std::shared_ptr<const Data> m_pData;
+
+		// render side: created on the first upload, the table itself works without GL
+		std::unique_ptr<UniformBuffer> m_pUniformBuffer;
+		std::shared_ptr<const Data> m_pUploadedData;
+	};
+
+}
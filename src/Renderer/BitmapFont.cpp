@@ -0,0 +1,107 @@
+#include "BitmapFont.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace Renderer {
+
+	namespace {
+		// one octal digit per row, top row first; 4 is the left pixel, 1 the right one
+		struct GlyphBits {
+			char character;
+			uint16_t rows;
+		};
+
+		const GlyphBits GLYPH_BITS[] = {
+			{ '0', 075557 }, { '1', 026227 }, { '2', 071747 }, { '3', 071317 }, { '4', 055711 },
+			{ '5', 074717 }, { '6', 074757 }, { '7', 071111 }, { '8', 075757 }, { '9', 075717 },
+			{ 'A', 025755 }, { 'B', 065656 }, { 'C', 034443 }, { 'D', 065556 }, { 'E', 074647 },
+			{ 'F', 074644 }, { 'G', 034553 }, { 'H', 055755 }, { 'I', 072227 }, { 'J', 011152 },
+			{ 'K', 055655 }, { 'L', 044447 }, { 'M', 057755 }, { 'N', 065555 }, { 'O', 025552 },
+			{ 'P', 065644 }, { 'Q', 025563 }, { 'R', 065655 }, { 'S', 034216 }, { 'T', 072222 },
+			{ 'U', 055557 }, { 'V', 055552 }, { 'W', 055775 }, { 'X', 055255 }, { 'Y', 055222 },
+			{ 'Z', 071247 },
+			{ '.', 000002 }, { ',', 000024 }, { ':', 002020 }, { ';', 002024 }, { '-', 000700 },
+			{ '+', 002720 }, { '=', 007070 }, { '/', 011244 }, { '%', 051245 }, { '(', 012221 },
+			{ ')', 042224 }, { '[', 064446 }, { ']', 031113 }, { '!', 022202 }, { '?', 071202 },
+			{ '#', 057575 }, { '*', 005250 }, { '_', 000007 }, { '\'', 022000 }, { '"', 055000 },
+			{ '<', 012421 }, { '>', 042124 }, { '|', 022222 }
+		};
+
+		// 16 x 6 cells with a pixel of padding right of and above every glyph
+		const unsigned int CELLS_COUNT_X = 16;
+		const unsigned int CELLS_COUNT_Y = 6;
+		const unsigned int CELL_WIDTH = BitmapFont::ADVANCE;
+		const unsigned int CELL_HEIGHT = BitmapFont::LINE_HEIGHT;
+		const unsigned int TEXTURE_WIDTH = CELLS_COUNT_X * CELL_WIDTH;
+		const unsigned int TEXTURE_HEIGHT = CELLS_COUNT_Y * CELL_HEIGHT;
+	}
+
+	BitmapFont::BitmapFont()
+	{
+		// RGBA, bottom row first like loaded images
+		std::vector<uint32_t> pixels(static_cast<size_t>(TEXTURE_WIDTH) * TEXTURE_HEIGHT, 0);
+		for (const GlyphBits& glyphBits : GLYPH_BITS)
+		{
+			const unsigned int index = static_cast<unsigned int>(glyphBits.character - FIRST_CHARACTER);
+			const unsigned int left = (index % CELLS_COUNT_X) * CELL_WIDTH;
+			const unsigned int bottom = (index / CELLS_COUNT_X) * CELL_HEIGHT;
+			for (unsigned int row = 0; row < GLYPH_HEIGHT; ++row)
+			{
+				const unsigned int rowBits = (glyphBits.rows >> (3 * (GLYPH_HEIGHT - 1 - row))) & 7;
+				for (unsigned int column = 0; column < GLYPH_WIDTH; ++column)
+				{
+					if (rowBits & (4 >> column))
+					{
+						pixels[static_cast<size_t>(bottom + GLYPH_HEIGHT - 1 - row) * TEXTURE_WIDTH + left + column] = 0xFFFFFFFFu;
+					}
+				}
+			}
+		}
+		m_pTexture = std::make_shared<Texture2D>(TEXTURE_WIDTH, TEXTURE_HEIGHT, reinterpret_cast<const unsigned char*>(pixels.data()), 4, GL_NEAREST);
+
+		auto cellSubTexture = [](const char character) {
+			const unsigned int index = static_cast<unsigned int>(character - FIRST_CHARACTER);
+			const glm::vec2 leftBottom(static_cast<float>((index % CELLS_COUNT_X) * CELL_WIDTH), static_cast<float>((index / CELLS_COUNT_X) * CELL_HEIGHT));
+			const glm::vec2 textureSize(TEXTURE_WIDTH, TEXTURE_HEIGHT);
+			return Texture2D::SubTexture2D(leftBottom / textureSize, (leftBottom + glm::vec2(GLYPH_WIDTH, GLYPH_HEIGHT)) / textureSize);
+		};
+		m_glyphs.fill(cellSubTexture('?'));
+		m_glyphs[0] = cellSubTexture(' ');
+		for (const GlyphBits& glyphBits : GLYPH_BITS)
+		{
+			m_glyphs[static_cast<size_t>(glyphBits.character - FIRST_CHARACTER)] = cellSubTexture(glyphBits.character);
+		}
+	}
+
+	const Texture2D::SubTexture2D& BitmapFont::glyph(const char character) const
+	{
+		const char upperCase = character >= 'a' && character <= 'z' ? static_cast<char>(character - 'a' + 'A') : character;
+		const unsigned int index = static_cast<unsigned char>(upperCase) - static_cast<unsigned int>(FIRST_CHARACTER);
+		return m_glyphs[index < GLYPHS_COUNT ? index : static_cast<unsigned int>('?' - FIRST_CHARACTER)];
+	}
+
+	glm::vec2 BitmapFont::measure(const std::string_view text, const float scale) const
+	{
+		size_t linesCount = 1;
+		size_t lineLength = 0;
+		size_t maxLineLength = 0;
+		for (const char character : text)
+		{
+			if (character == '\n')
+			{
+				++linesCount;
+				lineLength = 0;
+				continue;
+			}
+			maxLineLength = std::max(maxLineLength, ++lineLength);
+		}
+
+		// the padding after the last glyph and below the last line doesn't count
+		const float width = maxLineLength ? static_cast<float>(maxLineLength * ADVANCE - 1) : 0.f;
+		const float height = static_cast<float>(linesCount * LINE_HEIGHT - 1);
+		return scale * glm::vec2(width, height);
+	}
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Texture2D.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <array>
+#include <memory>
+#include <string_view>
+
+namespace Renderer {
+
+	// Fixed-width 3x5 pixel font built into the game. The glyphs are drawn
+	// into one small texture at startup, so there is no font file to ship and
+	// any amount of text shares a texture and goes out in one batch. Covers
+	// printable ASCII; lower case shows as upper case, anything else as '?'.
+	class BitmapFont {
+	public:
+		static constexpr unsigned int GLYPH_WIDTH = 3;
+		static constexpr unsigned int GLYPH_HEIGHT = 5;
+		// pixels from one glyph or line to the next at scale 1
+		static constexpr unsigned int ADVANCE = GLYPH_WIDTH + 1;
+		static constexpr unsigned int LINE_HEIGHT = GLYPH_HEIGHT + 1;
+
+		BitmapFont();
+
+		BitmapFont(const BitmapFont&) = delete;
+		BitmapFont& operator=(const BitmapFont&) = delete;
+
+		const Texture2D::SubTexture2D& glyph(const char character) const;
+		// nothing is drawn for these
+		static bool isBlank(const char character) { return character == ' ' || character == '\n'; }
+		const std::shared_ptr<Texture2D>& texture() const { return m_pTexture; }
+		// width of the longest line and height of all lines, in pixels
+		glm::vec2 measure(const std::string_view text, const float scale = 1.f) const;
+
+	private:
+		static constexpr char FIRST_CHARACTER = ' ';
+		static constexpr size_t GLYPHS_COUNT = 96;
+
+		std::shared_ptr<Texture2D> m_pTexture;
+		std::array<Texture2D::SubTexture2D, GLYPHS_COUNT> m_glyphs;
+	};
+
+}
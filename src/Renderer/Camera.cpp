@@ -0,0 +1,50 @@
+#include "Camera.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+
+namespace Renderer {
+
+	Camera::Camera(const glm::vec2& viewSize, const glm::vec2& position) :
+		m_viewSize(viewSize),
+		m_position(position),
+		m_bounds{ glm::vec2(0.f), glm::vec2(0.f) }
+	{
+	}
+
+	void Camera::setPosition(const glm::vec2& position)
+	{
+		m_position = position;
+		if (!m_hasBounds)
+		{
+			return;
+		}
+
+		for (glm::vec2::length_type axis = 0; axis < 2; ++axis)
+		{
+			const float boundsSize = m_bounds.max[axis] - m_bounds.min[axis];
+			if (boundsSize <= m_viewSize[axis])
+			{
+				m_position[axis] = m_bounds.min[axis] + 0.5f * (boundsSize - m_viewSize[axis]);
+			}
+			else
+			{
+				m_position[axis] = std::clamp(m_position[axis], m_bounds.min[axis], m_bounds.max[axis] - m_viewSize[axis]);
+			}
+		}
+	}
+
+	void Camera::setBounds(const ViewRect& bounds)
+	{
+		m_bounds = bounds;
+		m_hasBounds = true;
+		setPosition(m_position);
+	}
+
+	glm::mat4 Camera::projection() const
+	{
+		return glm::ortho(m_position.x, m_position.x + m_viewSize.x, m_position.y, m_position.y + m_viewSize.y, -100.f, 100.f);
+	}
+
+}
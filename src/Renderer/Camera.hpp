@@ -0,0 +1,44 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <glm/mat4x4.hpp>
+
+namespace Renderer {
+
+	// axis-aligned rectangle in world units
+	struct ViewRect {
+		glm::vec2 min;
+		glm::vec2 max;
+
+		bool overlaps(const glm::vec2& position, const glm::vec2& size) const
+		{
+			return position.x < max.x && position.x + size.x > min.x
+				&& position.y < max.y && position.y + size.y > min.y;
+		}
+	};
+
+	// The part of the world drawn to the native framebuffer. World units are
+	// native pixels with the origin at the bottom left, like sprite positions,
+	// so a camera at the origin shows exactly what was drawn before cameras.
+	class Camera {
+	public:
+		Camera(const glm::vec2& viewSize = glm::vec2(0.f), const glm::vec2& position = glm::vec2(0.f));
+
+		void setPosition(const glm::vec2& position);
+		void move(const glm::vec2& offset) { setPosition(m_position + offset); }
+		// keeps the view inside bounds; on an axis where the bounds are smaller than the view it is centred on them
+		void setBounds(const ViewRect& bounds);
+
+		const glm::vec2& position() const { return m_position; }
+		const glm::vec2& viewSize() const { return m_viewSize; }
+		ViewRect viewRect() const { return ViewRect{ m_position, m_position + m_viewSize }; }
+		glm::mat4 projection() const;
+
+	private:
+		glm::vec2 m_viewSize;
+		glm::vec2 m_position;
+		ViewRect m_bounds;
+		bool m_hasBounds = false;
+	};
+
+}
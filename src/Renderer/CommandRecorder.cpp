@@ -0,0 +1,71 @@
+#include "CommandRecorder.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
+namespace Renderer {
+
+	CommandRecorder::CommandRecorder(const unsigned int threadsCount) :
+		m_workers(threadsCount)
+	{
+		m_commandBuffers.reserve(m_workers.threadsCount());
+		for (unsigned int i = 0; i < m_workers.threadsCount(); ++i)
+		{
+			m_commandBuffers.emplace_back(std::make_unique<RenderQueue>());
+		}
+	}
+
+	void CommandRecorder::record(RenderQueue& renderQueue, const size_t itemsCount, const RecordFunction& recordRange)
+	{
+		const size_t workersCount = std::min<size_t>(m_workers.threadsCount(), std::max<size_t>(1, itemsCount / MIN_ITEMS_PER_THREAD));
+		if (workersCount == 1)
+		{
+			recordRange(renderQueue, 0, itemsCount);
+			return;
+		}
+
+		// the last worker to finish recording sizes the target, then every
+		// worker copies its buffer into its own slice of it; the pool runs
+		// each worker on its own thread, so waiting for the others is safe
+		std::mutex mutex;
+		std::condition_variable recordedCondition;
+		size_t recordedCount = 0;
+		std::vector<size_t> targetIndices(workersCount);
+
+		auto recordWorker = [&](const size_t worker) {
+			RenderQueue& commandBuffer = *m_commandBuffers[worker];
+			commandBuffer.clear();
+			recordRange(commandBuffer, itemsCount * worker / workersCount, itemsCount * (worker + 1) / workersCount);
+
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				if (++recordedCount == workersCount)
+				{
+					size_t commandsCount = 0;
+					for (size_t i = 0; i < workersCount; ++i)
+					{
+						targetIndices[i] = commandsCount;
+						commandsCount += m_commandBuffers[i]->size();
+					}
+					const size_t firstIndex = renderQueue.grow(commandsCount);
+					for (size_t& targetIndex : targetIndices)
+					{
+						targetIndex += firstIndex;
+					}
+					lock.unlock();
+					recordedCondition.notify_all();
+				}
+				else
+				{
+					recordedCondition.wait(lock, [&] { return recordedCount == workersCount; });
+				}
+			}
+
+			commandBuffer.copyTo(renderQueue, targetIndices[worker]);
+		};
+
+		m_workers.run(static_cast<unsigned int>(workersCount), recordWorker);
+	}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "RenderQueue.hpp"
+#include "WorkerPool.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Renderer {
+
+	// Records sprite commands on several threads. The items are split into
+	// contiguous ranges, one per thread, each thread submits its range into a
+	// command buffer of its own and then copies it into its slice of the
+	// target queue. The threads are kept for the lifetime of the recorder.
+	// The target ends up with the commands in item order, as if
+	// recorded on one thread, and is sorted and emitted on the render thread.
+	class CommandRecorder {
+	public:
+		// records the items [first, last) into commandBuffer
+		using RecordFunction = std::function<void(RenderQueue& commandBuffer, const size_t first, const size_t last)>;
+
+		// threadsCount 0 uses one thread per hardware thread
+		CommandRecorder(const unsigned int threadsCount = 0);
+
+		CommandRecorder(const CommandRecorder&) = delete;
+		CommandRecorder& operator=(const CommandRecorder&) = delete;
+
+		// appends the commands of itemsCount items to renderQueue, leaves it unsorted
+		void record(RenderQueue& renderQueue, const size_t itemsCount, const RecordFunction& recordRange);
+
+		unsigned int threadsCount() const { return m_workers.threadsCount(); }
+
+		// ranges shorter than this are not worth a thread
+		static constexpr size_t MIN_ITEMS_PER_THREAD = 512;
+
+	private:
+		WorkerPool m_workers;
+		std::vector<std::unique_ptr<RenderQueue>> m_commandBuffers;
+	};
+
+}
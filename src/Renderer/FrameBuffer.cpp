@@ -0,0 +1,67 @@
+#include "FrameBuffer.hpp"
+
+#include "GLStateCache.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace Renderer {
+
+	FrameBuffer::FrameBuffer(const unsigned int width, const unsigned int height) :
+		m_width(width),
+		m_height(height)
+	{
+		glGenTextures(1, &m_colorTexture);
+		GLStateCache::bindTexture(0, GL_TEXTURE_2D, m_colorTexture);
+		glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, m_width, m_height);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		GLStateCache::bindTexture(0, GL_TEXTURE_2D, 0);
+
+		glGenFramebuffers(1, &m_ID);
+		GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, m_ID);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_colorTexture, 0);
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			std::cerr << "Framebuffer " << m_width << "x" << m_height << " is incomplete" << std::endl;
+		}
+		GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	FrameBuffer::~FrameBuffer()
+	{
+		GLStateCache::deleteFramebuffer(m_ID);
+		GLStateCache::deleteTexture(m_colorTexture);
+	}
+
+	void FrameBuffer::bind() const
+	{
+		GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, m_ID);
+		glViewport(0, 0, m_width, m_height);
+	}
+
+	void FrameBuffer::blitTo(const GLuint targetFramebuffer, const unsigned int targetWidth, const unsigned int targetHeight) const
+	{
+		// a window smaller than the native size gets the image cropped at scale 1
+		const unsigned int scale = std::max(1u, std::min(targetWidth / m_width, targetHeight / m_height));
+		const GLint width = static_cast<GLint>(scale * m_width);
+		const GLint height = static_cast<GLint>(scale * m_height);
+		const GLint left = (static_cast<GLint>(targetWidth) - width) / 2;
+		const GLint bottom = (static_cast<GLint>(targetHeight) - height) / 2;
+
+		GLStateCache::bindFramebuffer(GL_READ_FRAMEBUFFER, m_ID);
+		GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, targetFramebuffer);
+		glViewport(0, 0, targetWidth, targetHeight);
+		glBlitFramebuffer(0, 0, m_width, m_height, left, bottom, left + width, bottom + height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	}
+
+	void FrameBuffer::readPixels(std::vector<unsigned char>& pixels) const
+	{
+		pixels.resize(4 * static_cast<size_t>(m_width) * m_height);
+		GLStateCache::bindFramebuffer(GL_READ_FRAMEBUFFER, m_ID);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/vec2.hpp>
+
+#include <vector>
+
+namespace Renderer {
+
+	// Offscreen RGBA8 color target of a fixed size. The game draws at its
+	// native resolution here and presents it scaled by a whole factor, so
+	// fragment cost doesn't depend on the window and pixels stay square.
+	class FrameBuffer {
+	public:
+		FrameBuffer(const unsigned int width, const unsigned int height);
+		~FrameBuffer();
+
+		FrameBuffer() = delete;
+		FrameBuffer(const FrameBuffer&) = delete;
+		FrameBuffer& operator=(const FrameBuffer&) = delete;
+
+		// binds for drawing and sets the viewport to the whole target
+		void bind() const;
+		// nearest-filtered blit centered in the target, the rest is left as is
+		void blitTo(const GLuint targetFramebuffer, const unsigned int targetWidth, const unsigned int targetHeight) const;
+		// RGBA rows, bottom row first
+		void readPixels(std::vector<unsigned char>& pixels) const;
+
+		GLuint id() const { return m_ID; }
+		unsigned int width() const { return m_width; }
+		unsigned int height() const { return m_height; }
+
+	private:
+		GLuint m_ID = 0;
+		GLuint m_colorTexture = 0;
+		unsigned int m_width;
+		unsigned int m_height;
+	};
+
+}
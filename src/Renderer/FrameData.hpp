@@ -0,0 +1,22 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+namespace Renderer {
+
+	// Mirrors the std140 "FrameData" uniform block declared by the shaders.
+	struct FrameData {
+		static constexpr GLuint BINDING_POINT = 0;
+		static constexpr const char* BLOCK_NAME = "FrameData";
+
+		glm::mat4 projection;
+		glm::vec4 viewport;
+		float time;
+		float padding[3];
+	};
+
+	static_assert(sizeof(FrameData) == 96, "FrameData must match the std140 layout");
+
+}
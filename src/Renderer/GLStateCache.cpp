@@ -0,0 +1,273 @@
+#include "GLStateCache.hpp"
+
+#include <numeric>
+
+namespace Renderer {
+
+	GLuint GLStateCache::m_program = GLStateCache::UNKNOWN;
+	GLuint GLStateCache::m_vertexArray = GLStateCache::UNKNOWN;
+	GLuint GLStateCache::m_activeTextureUnit = GLStateCache::UNKNOWN;
+	std::array<std::array<GLuint, static_cast<size_t>(GLStateCache::ETextureTarget::Count)>, GLStateCache::MAX_TEXTURE_UNITS> GLStateCache::m_textures;
+	std::array<GLuint, static_cast<size_t>(GLStateCache::EBufferTarget::Count)> GLStateCache::m_buffers;
+	std::array<GLuint, GLStateCache::MAX_UNIFORM_BUFFER_BINDINGS> GLStateCache::m_uniformBufferBindings;
+	GLuint GLStateCache::m_drawFramebuffer = GLStateCache::UNKNOWN;
+	GLuint GLStateCache::m_readFramebuffer = GLStateCache::UNKNOWN;
+	GLStateCache::Counters GLStateCache::m_frameCounters;
+
+	namespace {
+		struct CacheInitializer {
+			CacheInitializer() { GLStateCache::invalidate(); }
+		} cacheInitializer;
+	}
+
+	size_t GLStateCache::Counters::issuedTotal() const
+	{
+		return std::accumulate(issued.begin(), issued.end(), size_t(0));
+	}
+
+	size_t GLStateCache::Counters::elidedTotal() const
+	{
+		return std::accumulate(elided.begin(), elided.end(), size_t(0));
+	}
+
+	bool GLStateCache::change(GLuint& cached, const GLuint value, const EStateKind kind)
+	{
+		if (cached == value)
+		{
+			++m_frameCounters.elided[static_cast<size_t>(kind)];
+			return false;
+		}
+		cached = value;
+		++m_frameCounters.issued[static_cast<size_t>(kind)];
+		return true;
+	}
+
+	bool GLStateCache::textureTargetIndex(const GLenum target, size_t& index)
+	{
+		switch (target)
+		{
+		case GL_TEXTURE_2D:
+			index = static_cast<size_t>(ETextureTarget::Texture2D);
+			return true;
+		case GL_TEXTURE_2D_ARRAY:
+			index = static_cast<size_t>(ETextureTarget::Texture2DArray);
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool GLStateCache::bufferTargetIndex(const GLenum target, size_t& index)
+	{
+		switch (target)
+		{
+		case GL_ARRAY_BUFFER:
+			index = static_cast<size_t>(EBufferTarget::Array);
+			return true;
+		case GL_ELEMENT_ARRAY_BUFFER:
+			index = static_cast<size_t>(EBufferTarget::ElementArray);
+			return true;
+		case GL_UNIFORM_BUFFER:
+			index = static_cast<size_t>(EBufferTarget::Uniform);
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void GLStateCache::useProgram(const GLuint program)
+	{
+		if (change(m_program, program, EStateKind::Program))
+		{
+			glUseProgram(program);
+		}
+	}
+
+	void GLStateCache::bindVertexArray(const GLuint vertexArray)
+	{
+		if (change(m_vertexArray, vertexArray, EStateKind::VertexArray))
+		{
+			glBindVertexArray(vertexArray);
+			// the element array binding is part of the vertex array state
+			m_buffers[static_cast<size_t>(EBufferTarget::ElementArray)] = UNKNOWN;
+		}
+	}
+
+	void GLStateCache::bindTexture(const GLuint unit, const GLenum target, const GLuint texture)
+	{
+		size_t targetIndex = 0;
+		if (unit >= MAX_TEXTURE_UNITS || !textureTargetIndex(target, targetIndex))
+		{
+			m_activeTextureUnit = unit;
+			glActiveTexture(GL_TEXTURE0 + unit);
+			glBindTexture(target, texture);
+			++m_frameCounters.issued[static_cast<size_t>(EStateKind::ActiveTexture)];
+			++m_frameCounters.issued[static_cast<size_t>(EStateKind::Texture)];
+			return;
+		}
+
+		if (m_textures[unit][targetIndex] == texture)
+		{
+			++m_frameCounters.elided[static_cast<size_t>(EStateKind::Texture)];
+			return;
+		}
+
+		if (change(m_activeTextureUnit, unit, EStateKind::ActiveTexture))
+		{
+			glActiveTexture(GL_TEXTURE0 + unit);
+		}
+		change(m_textures[unit][targetIndex], texture, EStateKind::Texture);
+		glBindTexture(target, texture);
+	}
+
+	void GLStateCache::bindBuffer(const GLenum target, const GLuint buffer)
+	{
+		size_t targetIndex = 0;
+		if (!bufferTargetIndex(target, targetIndex))
+		{
+			glBindBuffer(target, buffer);
+			++m_frameCounters.issued[static_cast<size_t>(EStateKind::Buffer)];
+			return;
+		}
+
+		if (change(m_buffers[targetIndex], buffer, EStateKind::Buffer))
+		{
+			glBindBuffer(target, buffer);
+		}
+	}
+
+	void GLStateCache::bindBufferBase(const GLenum target, const GLuint index, const GLuint buffer)
+	{
+		if (target != GL_UNIFORM_BUFFER || index >= MAX_UNIFORM_BUFFER_BINDINGS)
+		{
+			glBindBufferBase(target, index, buffer);
+			++m_frameCounters.issued[static_cast<size_t>(EStateKind::Buffer)];
+			return;
+		}
+
+		if (change(m_uniformBufferBindings[index], buffer, EStateKind::Buffer))
+		{
+			glBindBufferBase(target, index, buffer);
+			// binding to an indexed target also binds the generic target
+			m_buffers[static_cast<size_t>(EBufferTarget::Uniform)] = buffer;
+		}
+	}
+
+	void GLStateCache::bindFramebuffer(const GLenum target, const GLuint framebuffer)
+	{
+		switch (target)
+		{
+		case GL_DRAW_FRAMEBUFFER:
+			if (change(m_drawFramebuffer, framebuffer, EStateKind::Framebuffer))
+			{
+				glBindFramebuffer(target, framebuffer);
+			}
+			break;
+		case GL_READ_FRAMEBUFFER:
+			if (change(m_readFramebuffer, framebuffer, EStateKind::Framebuffer))
+			{
+				glBindFramebuffer(target, framebuffer);
+			}
+			break;
+		default:
+			if (m_drawFramebuffer == framebuffer && m_readFramebuffer == framebuffer)
+			{
+				++m_frameCounters.elided[static_cast<size_t>(EStateKind::Framebuffer)];
+				return;
+			}
+			m_drawFramebuffer = framebuffer;
+			m_readFramebuffer = framebuffer;
+			++m_frameCounters.issued[static_cast<size_t>(EStateKind::Framebuffer)];
+			glBindFramebuffer(target, framebuffer);
+			break;
+		}
+	}
+
+	void GLStateCache::deleteProgram(const GLuint program)
+	{
+		if (m_program == program)
+		{
+			m_program = UNKNOWN;
+		}
+		glDeleteProgram(program);
+	}
+
+	void GLStateCache::deleteVertexArray(const GLuint vertexArray)
+	{
+		if (m_vertexArray == vertexArray)
+		{
+			m_vertexArray = 0;
+			m_buffers[static_cast<size_t>(EBufferTarget::ElementArray)] = UNKNOWN;
+		}
+		glDeleteVertexArrays(1, &vertexArray);
+	}
+
+	void GLStateCache::deleteTexture(const GLuint texture)
+	{
+		for (auto& unitTextures : m_textures)
+		{
+			for (auto& boundTexture : unitTextures)
+			{
+				if (boundTexture == texture)
+				{
+					boundTexture = 0;
+				}
+			}
+		}
+		glDeleteTextures(1, &texture);
+	}
+
+	void GLStateCache::deleteBuffer(const GLuint buffer)
+	{
+		for (auto& boundBuffer : m_buffers)
+		{
+			if (boundBuffer == buffer)
+			{
+				boundBuffer = 0;
+			}
+		}
+		for (auto& boundBuffer : m_uniformBufferBindings)
+		{
+			if (boundBuffer == buffer)
+			{
+				boundBuffer = 0;
+			}
+		}
+		glDeleteBuffers(1, &buffer);
+	}
+
+	void GLStateCache::deleteFramebuffer(const GLuint framebuffer)
+	{
+		// deleting a bound framebuffer reverts the binding to the default one
+		if (m_drawFramebuffer == framebuffer)
+		{
+			m_drawFramebuffer = 0;
+		}
+		if (m_readFramebuffer == framebuffer)
+		{
+			m_readFramebuffer = 0;
+		}
+		glDeleteFramebuffers(1, &framebuffer);
+	}
+
+	void GLStateCache::invalidate()
+	{
+		m_program = UNKNOWN;
+		m_vertexArray = UNKNOWN;
+		m_activeTextureUnit = UNKNOWN;
+		for (auto& unitTextures : m_textures)
+		{
+			unitTextures.fill(UNKNOWN);
+		}
+		m_buffers.fill(UNKNOWN);
+		m_uniformBufferBindings.fill(UNKNOWN);
+		m_drawFramebuffer = UNKNOWN;
+		m_readFramebuffer = UNKNOWN;
+	}
+
+	void GLStateCache::beginFrame()
+	{
+		m_frameCounters = Counters();
+	}
+
+}
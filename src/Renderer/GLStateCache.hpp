@@ -0,0 +1,90 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstddef>
+
+namespace Renderer {
+
+	// Shadow copy of the GL bindings used by the renderer. Every bind in
+	// src/Renderer goes through here, so a call that wouldn't change the
+	// current binding is dropped before it reaches the driver.
+	class GLStateCache {
+	public:
+		enum class EStateKind {
+			Program,
+			VertexArray,
+			ActiveTexture,
+			Texture,
+			Buffer,
+			Framebuffer,
+			Count
+		};
+
+		struct Counters {
+			std::array<size_t, static_cast<size_t>(EStateKind::Count)> issued{};
+			std::array<size_t, static_cast<size_t>(EStateKind::Count)> elided{};
+
+			size_t issuedTotal() const;
+			size_t elidedTotal() const;
+		};
+
+		static void useProgram(const GLuint program);
+		static void bindVertexArray(const GLuint vertexArray);
+		static void bindTexture(const GLuint unit, const GLenum target, const GLuint texture);
+		static void bindBuffer(const GLenum target, const GLuint buffer);
+		static void bindBufferBase(const GLenum target, const GLuint index, const GLuint buffer);
+		// GL_FRAMEBUFFER binds both the draw and the read framebuffer
+		static void bindFramebuffer(const GLenum target, const GLuint framebuffer);
+
+		static void deleteProgram(const GLuint program);
+		static void deleteVertexArray(const GLuint vertexArray);
+		static void deleteTexture(const GLuint texture);
+		static void deleteBuffer(const GLuint buffer);
+		static void deleteFramebuffer(const GLuint framebuffer);
+
+		// forget everything, e.g. after GL calls made outside of the cache
+		static void invalidate();
+
+		static void beginFrame();
+		static const Counters& frameCounters() { return m_frameCounters; }
+
+		static constexpr size_t MAX_TEXTURE_UNITS = 16;
+		static constexpr size_t MAX_UNIFORM_BUFFER_BINDINGS = 16;
+
+		GLStateCache() = delete;
+		~GLStateCache() = delete;
+
+	private:
+		enum class ETextureTarget {
+			Texture2D,
+			Texture2DArray,
+			Count
+		};
+
+		enum class EBufferTarget {
+			Array,
+			ElementArray,
+			Uniform,
+			Count
+		};
+
+		static constexpr GLuint UNKNOWN = ~0u;
+
+		static bool textureTargetIndex(const GLenum target, size_t& index);
+		static bool bufferTargetIndex(const GLenum target, size_t& index);
+		static bool change(GLuint& cached, const GLuint value, const EStateKind kind);
+
+		static GLuint m_program;
+		static GLuint m_vertexArray;
+		static GLuint m_activeTextureUnit;
+		static std::array<std::array<GLuint, static_cast<size_t>(ETextureTarget::Count)>, MAX_TEXTURE_UNITS> m_textures;
+		static std::array<GLuint, static_cast<size_t>(EBufferTarget::Count)> m_buffers;
+		static std::array<GLuint, MAX_UNIFORM_BUFFER_BINDINGS> m_uniformBufferBindings;
+		static GLuint m_drawFramebuffer;
+		static GLuint m_readFramebuffer;
+		static Counters m_frameCounters;
+	};
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Renderer {
+
+	// Binary trace of the GL calls the renderer makes, written by
+	// GLTraceRecorder and replayed by GLTracePlayer. A file is the magic and
+	// the version followed by commands:
+	//   uint16 op | uint8 argsCount | int64 args[argsCount] | uint8 hasData | [uint64 size | data]
+	// Object names, sync objects and uniform locations are stored as the
+	// recording saw them and remapped on replay. Frames end with FrameEnd;
+	// everything before the first one is setup, replayed once.
+	namespace GLTrace {
+
+		constexpr char MAGIC[8] = { 'B', 'C', 'G', 'L', 'T', 'R', 'C', '\0' };
+		constexpr uint32_t VERSION = 1;
+		constexpr size_t MAX_ARGS = 12;
+
+		enum class EOp : uint16_t {
+			FrameEnd,
+
+			GenBuffer,
+			DeleteBuffer,
+			BindBuffer,
+			BindBufferBase,
+			BufferData,
+			BufferSubData,
+			BufferStorage,
+			MapBufferRange,
+			UnmapBuffer,
+			// bytes written through a persistent mapping: buffer, offset
+			MappedWrite,
+
+			GenVertexArray,
+			DeleteVertexArray,
+			BindVertexArray,
+			EnableVertexAttribArray,
+			VertexAttribPointer,
+			VertexAttribIPointer,
+
+			GenTexture,
+			DeleteTexture,
+			BindTexture,
+			ActiveTexture,
+			TexParameteri,
+			TexStorage2D,
+			TexImage3D,
+			TexSubImage3D,
+			GenerateMipmap,
+			PixelStorei,
+
+			CreateShader,
+			ShaderSource,
+			CompileShader,
+			AttachShader,
+			LinkProgram,
+			DeleteShader,
+			CreateProgram,
+			DeleteProgram,
+			UseProgram,
+			// program, recorded result; the name is the data
+			GetUniformLocation,
+			GetUniformBlockIndex,
+			UniformBlockBinding,
+			ProgramUniform1fv,
+			ProgramUniform2fv,
+			ProgramUniform4fv,
+			ProgramUniformMatrix4fv,
+			ProgramUniform1iv,
+
+			GenFramebuffer,
+			DeleteFramebuffer,
+			BindFramebuffer,
+			FramebufferTexture2D,
+			BlitFramebuffer,
+			Viewport,
+			Clear,
+			ClearColor,
+
+			DrawArrays,
+			DrawElements,
+			DrawElementsBaseVertex,
+
+			FenceSync,
+			ClientWaitSync,
+			DeleteSync,
+			Finish,
+
+			Count
+		};
+
+		struct Command {
+			EOp op;
+			uint8_t argsCount;
+			int64_t args[MAX_ARGS];
+			// offset into the trace data, NO_DATA if the command has none
+			size_t dataOffset;
+			size_t dataSize;
+		};
+
+		constexpr size_t NO_DATA = static_cast<size_t>(-1);
+
+	}
+
+}
@@ -0,0 +1,456 @@
+#include "GLTracePlayer.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace Renderer {
+
+	using GLTrace::EOp;
+
+	namespace {
+		template <typename T>
+		bool read(const std::vector<unsigned char>& file, size_t& position, T& value)
+		{
+			if (position + sizeof(T) > file.size())
+			{
+				return false;
+			}
+			std::memcpy(&value, file.data() + position, sizeof(T));
+			position += sizeof(T);
+			return true;
+		}
+
+		GLfloat floatArg(const int64_t arg)
+		{
+			const int32_t bits = static_cast<int32_t>(arg);
+			GLfloat value = 0.f;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		const void* pointerArg(const int64_t arg)
+		{
+			return reinterpret_cast<const void*>(static_cast<uintptr_t>(arg));
+		}
+	}
+
+	bool GLTracePlayer::load(const std::string& path)
+	{
+		std::ifstream traceFile(path, std::ios::binary);
+		if (!traceFile.is_open())
+		{
+			std::cerr << "Can't open GL trace: " << path << std::endl;
+			return false;
+		}
+		const std::vector<unsigned char> file((std::istreambuf_iterator<char>(traceFile)), std::istreambuf_iterator<char>());
+
+		char magic[sizeof(GLTrace::MAGIC)];
+		uint32_t version = 0;
+		size_t position = 0;
+		if (!read(file, position, magic) || std::memcmp(magic, GLTrace::MAGIC, sizeof(magic)) != 0
+			|| !read(file, position, version) || version != GLTrace::VERSION)
+		{
+			std::cerr << "Not a GL trace of version " << GLTrace::VERSION << ": " << path << std::endl;
+			return false;
+		}
+
+		m_commands.clear();
+		m_data.clear();
+		m_setupEnd = 0;
+		size_t frameEndsCount = 0;
+		while (position < file.size())
+		{
+			GLTrace::Command command{};
+			uint16_t op = 0;
+			uint8_t hasData = 0;
+			bool isValid = read(file, position, op) && op < static_cast<uint16_t>(EOp::Count)
+						   && read(file, position, command.argsCount) && command.argsCount <= GLTrace::MAX_ARGS;
+			for (uint8_t i = 0; isValid && i < command.argsCount; ++i)
+			{
+				isValid = read(file, position, command.args[i]);
+			}
+			isValid = isValid && read(file, position, hasData);
+
+			command.op = static_cast<EOp>(op);
+			command.dataOffset = GLTrace::NO_DATA;
+			if (isValid && hasData)
+			{
+				uint64_t size = 0;
+				isValid = read(file, position, size) && position + size <= file.size();
+				if (isValid)
+				{
+					command.dataOffset = m_data.size();
+					command.dataSize = static_cast<size_t>(size);
+					m_data.insert(m_data.end(), file.begin() + position, file.begin() + position + size);
+					position += size;
+				}
+			}
+
+			if (!isValid)
+			{
+				std::cerr << "GL trace is truncated after " << m_commands.size() << " commands: " << path << std::endl;
+				return false;
+			}
+
+			m_commands.push_back(command);
+			if (command.op == EOp::FrameEnd && ++frameEndsCount == 1)
+			{
+				m_setupEnd = m_commands.size();
+			}
+		}
+
+		m_framesCount = frameEndsCount > 0 ? frameEndsCount - 1 : 0;
+		if (m_framesCount == 0)
+		{
+			std::cerr << "GL trace has no frames after the first one: " << path << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	void GLTracePlayer::playSetup()
+	{
+		play(0, m_setupEnd);
+	}
+
+	void GLTracePlayer::playFrames()
+	{
+		play(m_setupEnd, m_commands.size());
+	}
+
+	void GLTracePlayer::play(const size_t firstCommand, const size_t lastCommand)
+	{
+		for (size_t i = firstCommand; i < lastCommand; ++i)
+		{
+			execute(m_commands[i]);
+		}
+	}
+
+	const void* GLTracePlayer::data(const GLTrace::Command& command) const
+	{
+		return command.dataOffset == GLTrace::NO_DATA ? nullptr : m_data.data() + command.dataOffset;
+	}
+
+	GLuint GLTracePlayer::name(const std::unordered_map<int64_t, GLuint>& names, const int64_t recordedName) const
+	{
+		const auto it = names.find(recordedName);
+		return it == names.end() ? 0 : it->second;
+	}
+
+	GLint GLTracePlayer::uniformLocation(const int64_t program, const int64_t recordedLocation) const
+	{
+		const auto programIt = m_uniformLocations.find(program);
+		if (programIt != m_uniformLocations.end())
+		{
+			const auto it = programIt->second.find(recordedLocation);
+			if (it != programIt->second.end())
+			{
+				return it->second;
+			}
+		}
+		// locations read through glGetActiveUniform only; the same driver gives the same ones
+		return static_cast<GLint>(recordedLocation);
+	}
+
+	int64_t& GLTracePlayer::boundBuffer(const GLenum target)
+	{
+		return m_boundBuffers[target];
+	}
+
+	void GLTracePlayer::execute(const GLTrace::Command& command)
+	{
+		const int64_t* args = command.args;
+		switch (command.op)
+		{
+		case EOp::FrameEnd:
+			break;
+
+		case EOp::GenBuffer:
+			glGenBuffers(1, &m_buffers[args[0]]);
+			break;
+		case EOp::DeleteBuffer:
+		{
+			const GLuint buffer = name(m_buffers, args[0]);
+			glDeleteBuffers(1, &buffer);
+			m_buffers.erase(args[0]);
+			m_mappings.erase(args[0]);
+			break;
+		}
+		case EOp::BindBuffer:
+			boundBuffer(static_cast<GLenum>(args[0])) = args[1];
+			glBindBuffer(static_cast<GLenum>(args[0]), name(m_buffers, args[1]));
+			break;
+		case EOp::BindBufferBase:
+			boundBuffer(static_cast<GLenum>(args[0])) = args[2];
+			glBindBufferBase(static_cast<GLenum>(args[0]), static_cast<GLuint>(args[1]), name(m_buffers, args[2]));
+			break;
+		case EOp::BufferData:
+			glBufferData(static_cast<GLenum>(args[0]), static_cast<GLsizeiptr>(args[1]), data(command), static_cast<GLenum>(args[2]));
+			break;
+		case EOp::BufferSubData:
+			glBufferSubData(static_cast<GLenum>(args[0]), static_cast<GLintptr>(args[1]), static_cast<GLsizeiptr>(args[2]), data(command));
+			break;
+		case EOp::BufferStorage:
+			glBufferStorage(static_cast<GLenum>(args[0]), static_cast<GLsizeiptr>(args[1]), data(command), static_cast<GLbitfield>(args[2]));
+			break;
+		case EOp::MapBufferRange:
+		{
+			const GLenum target = static_cast<GLenum>(args[0]);
+			Mapping& mapping = m_mappings[boundBuffer(target)];
+			mapping.pData = static_cast<unsigned char*>(glMapBufferRange(target, static_cast<GLintptr>(args[1]), static_cast<GLsizeiptr>(args[2]), static_cast<GLbitfield>(args[3])));
+			mapping.offset = static_cast<GLintptr>(args[1]);
+			break;
+		}
+		case EOp::UnmapBuffer:
+			m_mappings.erase(boundBuffer(static_cast<GLenum>(args[0])));
+			glUnmapBuffer(static_cast<GLenum>(args[0]));
+			break;
+		case EOp::MappedWrite:
+		{
+			const auto it = m_mappings.find(args[0]);
+			if (it != m_mappings.end() && it->second.pData && command.dataOffset != GLTrace::NO_DATA)
+			{
+				std::memcpy(it->second.pData + (args[1] - it->second.offset), data(command), command.dataSize);
+			}
+			break;
+		}
+
+		case EOp::GenVertexArray:
+			glGenVertexArrays(1, &m_vertexArrays[args[0]]);
+			break;
+		case EOp::DeleteVertexArray:
+		{
+			const GLuint vertexArray = name(m_vertexArrays, args[0]);
+			glDeleteVertexArrays(1, &vertexArray);
+			m_vertexArrays.erase(args[0]);
+			break;
+		}
+		case EOp::BindVertexArray:
+			glBindVertexArray(name(m_vertexArrays, args[0]));
+			break;
+		case EOp::EnableVertexAttribArray:
+			glEnableVertexAttribArray(static_cast<GLuint>(args[0]));
+			break;
+		case EOp::VertexAttribPointer:
+			glVertexAttribPointer(static_cast<GLuint>(args[0]), static_cast<GLint>(args[1]), static_cast<GLenum>(args[2]),
+								  static_cast<GLboolean>(args[3]), static_cast<GLsizei>(args[4]), pointerArg(args[5]));
+			break;
+		case EOp::VertexAttribIPointer:
+			glVertexAttribIPointer(static_cast<GLuint>(args[0]), static_cast<GLint>(args[1]), static_cast<GLenum>(args[2]),
+								   static_cast<GLsizei>(args[3]), pointerArg(args[4]));
+			break;
+
+		case EOp::GenTexture:
+			glGenTextures(1, &m_textures[args[0]]);
+			break;
+		case EOp::DeleteTexture:
+		{
+			const GLuint texture = name(m_textures, args[0]);
+			glDeleteTextures(1, &texture);
+			m_textures.erase(args[0]);
+			break;
+		}
+		case EOp::BindTexture:
+			glBindTexture(static_cast<GLenum>(args[0]), name(m_textures, args[1]));
+			break;
+		case EOp::ActiveTexture:
+			glActiveTexture(static_cast<GLenum>(args[0]));
+			break;
+		case EOp::TexParameteri:
+			glTexParameteri(static_cast<GLenum>(args[0]), static_cast<GLenum>(args[1]), static_cast<GLint>(args[2]));
+			break;
+		case EOp::TexStorage2D:
+			glTexStorage2D(static_cast<GLenum>(args[0]), static_cast<GLsizei>(args[1]), static_cast<GLenum>(args[2]),
+						   static_cast<GLsizei>(args[3]), static_cast<GLsizei>(args[4]));
+			break;
+		case EOp::TexImage3D:
+			glTexImage3D(static_cast<GLenum>(args[0]), static_cast<GLint>(args[1]), static_cast<GLint>(args[2]),
+						 static_cast<GLsizei>(args[3]), static_cast<GLsizei>(args[4]), static_cast<GLsizei>(args[5]),
+						 static_cast<GLint>(args[6]), static_cast<GLenum>(args[7]), static_cast<GLenum>(args[8]), data(command));
+			break;
+		case EOp::TexSubImage3D:
+			glTexSubImage3D(static_cast<GLenum>(args[0]), static_cast<GLint>(args[1]),
+							static_cast<GLint>(args[2]), static_cast<GLint>(args[3]), static_cast<GLint>(args[4]),
+							static_cast<GLsizei>(args[5]), static_cast<GLsizei>(args[6]), static_cast<GLsizei>(args[7]),
+							static_cast<GLenum>(args[8]), static_cast<GLenum>(args[9]), data(command));
+			break;
+		case EOp::GenerateMipmap:
+			glGenerateMipmap(static_cast<GLenum>(args[0]));
+			break;
+		case EOp::PixelStorei:
+			glPixelStorei(static_cast<GLenum>(args[0]), static_cast<GLint>(args[1]));
+			break;
+
+		case EOp::CreateShader:
+			m_shaders[args[1]] = glCreateShader(static_cast<GLenum>(args[0]));
+			break;
+		case EOp::ShaderSource:
+		{
+			const GLchar* source = static_cast<const GLchar*>(data(command));
+			const GLint length = static_cast<GLint>(command.dataSize);
+			glShaderSource(name(m_shaders, args[0]), 1, &source, &length);
+			break;
+		}
+		case EOp::CompileShader:
+			glCompileShader(name(m_shaders, args[0]));
+			break;
+		case EOp::AttachShader:
+			glAttachShader(name(m_programs, args[0]), name(m_shaders, args[1]));
+			break;
+		case EOp::LinkProgram:
+			glLinkProgram(name(m_programs, args[0]));
+			break;
+		case EOp::DeleteShader:
+			glDeleteShader(name(m_shaders, args[0]));
+			m_shaders.erase(args[0]);
+			break;
+		case EOp::CreateProgram:
+			m_programs[args[0]] = glCreateProgram();
+			break;
+		case EOp::DeleteProgram:
+			glDeleteProgram(name(m_programs, args[0]));
+			m_programs.erase(args[0]);
+			m_uniformLocations.erase(args[0]);
+			m_uniformBlockIndices.erase(args[0]);
+			break;
+		case EOp::UseProgram:
+			glUseProgram(name(m_programs, args[0]));
+			break;
+		case EOp::GetUniformLocation:
+		{
+			const std::string uniformName(static_cast<const char*>(data(command)), command.dataSize);
+			m_uniformLocations[args[0]][args[1]] = glGetUniformLocation(name(m_programs, args[0]), uniformName.c_str());
+			break;
+		}
+		case EOp::GetUniformBlockIndex:
+		{
+			const std::string blockName(static_cast<const char*>(data(command)), command.dataSize);
+			m_uniformBlockIndices[args[0]][args[1]] = glGetUniformBlockIndex(name(m_programs, args[0]), blockName.c_str());
+			break;
+		}
+		case EOp::UniformBlockBinding:
+		{
+			const GLuint blockIndex = m_uniformBlockIndices[args[0]].count(args[1]) ? m_uniformBlockIndices[args[0]][args[1]] : static_cast<GLuint>(args[1]);
+			glUniformBlockBinding(name(m_programs, args[0]), blockIndex, static_cast<GLuint>(args[2]));
+			break;
+		}
+		case EOp::ProgramUniform1fv:
+			glProgramUniform1fv(name(m_programs, args[0]), uniformLocation(args[0], args[1]), static_cast<GLsizei>(args[2]), static_cast<const GLfloat*>(data(command)));
+			break;
+		case EOp::ProgramUniform2fv:
+			glProgramUniform2fv(name(m_programs, args[0]), uniformLocation(args[0], args[1]), static_cast<GLsizei>(args[2]), static_cast<const GLfloat*>(data(command)));
+			break;
+		case EOp::ProgramUniform4fv:
+			glProgramUniform4fv(name(m_programs, args[0]), uniformLocation(args[0], args[1]), static_cast<GLsizei>(args[2]), static_cast<const GLfloat*>(data(command)));
+			break;
+		case EOp::ProgramUniformMatrix4fv:
+			glProgramUniformMatrix4fv(name(m_programs, args[0]), uniformLocation(args[0], args[1]), static_cast<GLsizei>(args[2]),
+									  static_cast<GLboolean>(args[3]), static_cast<const GLfloat*>(data(command)));
+			break;
+		case EOp::ProgramUniform1iv:
+			glProgramUniform1iv(name(m_programs, args[0]), uniformLocation(args[0], args[1]), static_cast<GLsizei>(args[2]), static_cast<const GLint*>(data(command)));
+			break;
+
+		case EOp::GenFramebuffer:
+			glGenFramebuffers(1, &m_framebuffers[args[0]]);
+			break;
+		case EOp::DeleteFramebuffer:
+		{
+			const GLuint framebuffer = name(m_framebuffers, args[0]);
+			glDeleteFramebuffers(1, &framebuffer);
+			m_framebuffers.erase(args[0]);
+			break;
+		}
+		case EOp::BindFramebuffer:
+		{
+			const GLenum target = static_cast<GLenum>(args[0]);
+			const GLuint framebuffer = name(m_framebuffers, args[1]);
+			glBindFramebuffer(target, framebuffer);
+			if (target != GL_DRAW_FRAMEBUFFER)
+			{
+				m_readFramebuffer = framebuffer;
+			}
+			break;
+		}
+		case EOp::FramebufferTexture2D:
+			glFramebufferTexture2D(static_cast<GLenum>(args[0]), static_cast<GLenum>(args[1]), static_cast<GLenum>(args[2]),
+								   name(m_textures, args[3]), static_cast<GLint>(args[4]));
+			break;
+		case EOp::BlitFramebuffer:
+			glBlitFramebuffer(static_cast<GLint>(args[0]), static_cast<GLint>(args[1]), static_cast<GLint>(args[2]), static_cast<GLint>(args[3]),
+							  static_cast<GLint>(args[4]), static_cast<GLint>(args[5]), static_cast<GLint>(args[6]), static_cast<GLint>(args[7]),
+							  static_cast<GLbitfield>(args[8]), static_cast<GLenum>(args[9]));
+			m_blitSource = BlitSource{ m_readFramebuffer, static_cast<GLsizei>(args[2] - args[0]), static_cast<GLsizei>(args[3] - args[1]) };
+			break;
+		case EOp::Viewport:
+			glViewport(static_cast<GLint>(args[0]), static_cast<GLint>(args[1]), static_cast<GLsizei>(args[2]), static_cast<GLsizei>(args[3]));
+			break;
+		case EOp::Clear:
+			glClear(static_cast<GLbitfield>(args[0]));
+			break;
+		case EOp::ClearColor:
+			glClearColor(floatArg(args[0]), floatArg(args[1]), floatArg(args[2]), floatArg(args[3]));
+			break;
+
+		case EOp::DrawArrays:
+			glDrawArrays(static_cast<GLenum>(args[0]), static_cast<GLint>(args[1]), static_cast<GLsizei>(args[2]));
+			break;
+		case EOp::DrawElements:
+			glDrawElements(static_cast<GLenum>(args[0]), static_cast<GLsizei>(args[1]), static_cast<GLenum>(args[2]), pointerArg(args[3]));
+			break;
+		case EOp::DrawElementsBaseVertex:
+			glDrawElementsBaseVertex(static_cast<GLenum>(args[0]), static_cast<GLsizei>(args[1]), static_cast<GLenum>(args[2]),
+									 pointerArg(args[3]), static_cast<GLint>(args[4]));
+			break;
+
+		case EOp::FenceSync:
+			m_syncs[args[2]] = glFenceSync(static_cast<GLenum>(args[0]), static_cast<GLbitfield>(args[1]));
+			break;
+		case EOp::ClientWaitSync:
+		{
+			// a fence deleted in a later frame is gone when the frames loop round
+			const auto it = m_syncs.find(args[0]);
+			if (it != m_syncs.end())
+			{
+				glClientWaitSync(it->second, static_cast<GLbitfield>(args[1]), static_cast<GLuint64>(args[2]));
+			}
+			break;
+		}
+		case EOp::DeleteSync:
+		{
+			const auto it = m_syncs.find(args[0]);
+			if (it != m_syncs.end())
+			{
+				glDeleteSync(it->second);
+				m_syncs.erase(it);
+			}
+			break;
+		}
+		case EOp::Finish:
+			glFinish();
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	bool GLTracePlayer::readBlitSource(std::vector<unsigned char>& pixels, GLsizei& width, GLsizei& height) const
+	{
+		if (m_blitSource.width <= 0 || m_blitSource.height <= 0)
+		{
+			return false;
+		}
+
+		width = m_blitSource.width;
+		height = m_blitSource.height;
+		pixels.resize(4 * static_cast<size_t>(width) * height);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_blitSource.framebuffer);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		return true;
+	}
+
+}
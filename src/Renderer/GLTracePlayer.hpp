@@ -0,0 +1,73 @@
+#pragma once
+
+#include "GLTrace.hpp"
+
+#include <glad/glad.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Renderer {
+
+	// Replays a GLTrace in the current context. The setup (everything before
+	// the first frame end) is played once, frames can then be played any
+	// number of times: the recorded first frame creates objects the game makes
+	// lazily, so it belongs to the setup as well.
+	class GLTracePlayer {
+	public:
+		bool load(const std::string& path);
+
+		void playSetup();
+		void playFrames();
+
+		// the framebuffer the last played frame blitted from, the game's native
+		// image, as RGBA rows bottom row first; false if nothing was blitted
+		bool readBlitSource(std::vector<unsigned char>& pixels, GLsizei& width, GLsizei& height) const;
+
+		size_t framesCount() const { return m_framesCount; }
+		size_t commandsCount() const { return m_commands.size(); }
+		size_t dataSize() const { return m_data.size(); }
+
+	private:
+		struct BlitSource {
+			GLuint framebuffer = 0;
+			GLsizei width = 0;
+			GLsizei height = 0;
+		};
+
+		struct Mapping {
+			unsigned char* pData = nullptr;
+			GLintptr offset = 0;
+		};
+
+		void play(const size_t firstCommand, const size_t lastCommand);
+		void execute(const GLTrace::Command& command);
+		const void* data(const GLTrace::Command& command) const;
+		GLuint name(const std::unordered_map<int64_t, GLuint>& names, const int64_t recordedName) const;
+		GLint uniformLocation(const int64_t program, const int64_t recordedLocation) const;
+		int64_t& boundBuffer(const GLenum target);
+
+		std::vector<GLTrace::Command> m_commands;
+		std::vector<unsigned char> m_data;
+		size_t m_setupEnd = 0;
+		size_t m_framesCount = 0;
+
+		std::unordered_map<int64_t, GLuint> m_buffers;
+		std::unordered_map<int64_t, GLuint> m_vertexArrays;
+		std::unordered_map<int64_t, GLuint> m_textures;
+		std::unordered_map<int64_t, GLuint> m_shaders;
+		std::unordered_map<int64_t, GLuint> m_programs;
+		std::unordered_map<int64_t, GLuint> m_framebuffers;
+		std::unordered_map<int64_t, GLsync> m_syncs;
+		// recorded program and location to the replayed location
+		std::unordered_map<int64_t, std::unordered_map<int64_t, GLint>> m_uniformLocations;
+		std::unordered_map<int64_t, std::unordered_map<int64_t, GLuint>> m_uniformBlockIndices;
+		// recorded buffer name to its mapping
+		std::unordered_map<int64_t, Mapping> m_mappings;
+		std::unordered_map<GLenum, int64_t> m_boundBuffers;
+		GLuint m_readFramebuffer = 0;
+		BlitSource m_blitSource;
+	};
+
+}
@@ -0,0 +1,518 @@
+#include "GLTraceRecorder.hpp"
+
+#include "GLTrace.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+
+namespace Renderer {
+
+	bool GLTraceRecorder::m_isRecording = false;
+	unsigned int GLTraceRecorder::m_framesCount = 0;
+
+	namespace {
+		using GLTrace::EOp;
+
+		std::ofstream traceFile;
+		GLint unpackAlignment = 4;
+
+		struct OriginalEntries {
+			PFNGLGENBUFFERSPROC GenBuffers;
+			PFNGLDELETEBUFFERSPROC DeleteBuffers;
+			PFNGLBINDBUFFERPROC BindBuffer;
+			PFNGLBINDBUFFERBASEPROC BindBufferBase;
+			PFNGLBUFFERDATAPROC BufferData;
+			PFNGLBUFFERSUBDATAPROC BufferSubData;
+			PFNGLBUFFERSTORAGEPROC BufferStorage;
+			PFNGLMAPBUFFERRANGEPROC MapBufferRange;
+			PFNGLUNMAPBUFFERPROC UnmapBuffer;
+
+			PFNGLGENVERTEXARRAYSPROC GenVertexArrays;
+			PFNGLDELETEVERTEXARRAYSPROC DeleteVertexArrays;
+			PFNGLBINDVERTEXARRAYPROC BindVertexArray;
+			PFNGLENABLEVERTEXATTRIBARRAYPROC EnableVertexAttribArray;
+			PFNGLVERTEXATTRIBPOINTERPROC VertexAttribPointer;
+			PFNGLVERTEXATTRIBIPOINTERPROC VertexAttribIPointer;
+
+			PFNGLGENTEXTURESPROC GenTextures;
+			PFNGLDELETETEXTURESPROC DeleteTextures;
+			PFNGLBINDTEXTUREPROC BindTexture;
+			PFNGLACTIVETEXTUREPROC ActiveTexture;
+			PFNGLTEXPARAMETERIPROC TexParameteri;
+			PFNGLTEXSTORAGE2DPROC TexStorage2D;
+			PFNGLTEXIMAGE3DPROC TexImage3D;
+			PFNGLTEXSUBIMAGE3DPROC TexSubImage3D;
+			PFNGLGENERATEMIPMAPPROC GenerateMipmap;
+			PFNGLPIXELSTOREIPROC PixelStorei;
+
+			PFNGLCREATESHADERPROC CreateShader;
+			PFNGLSHADERSOURCEPROC ShaderSource;
+			PFNGLCOMPILESHADERPROC CompileShader;
+			PFNGLATTACHSHADERPROC AttachShader;
+			PFNGLLINKPROGRAMPROC LinkProgram;
+			PFNGLDELETESHADERPROC DeleteShader;
+			PFNGLCREATEPROGRAMPROC CreateProgram;
+			PFNGLDELETEPROGRAMPROC DeleteProgram;
+			PFNGLUSEPROGRAMPROC UseProgram;
+			PFNGLGETUNIFORMLOCATIONPROC GetUniformLocation;
+			PFNGLGETUNIFORMBLOCKINDEXPROC GetUniformBlockIndex;
+			PFNGLUNIFORMBLOCKBINDINGPROC UniformBlockBinding;
+			PFNGLPROGRAMUNIFORM1FVPROC ProgramUniform1fv;
+			PFNGLPROGRAMUNIFORM2FVPROC ProgramUniform2fv;
+			PFNGLPROGRAMUNIFORM4FVPROC ProgramUniform4fv;
+			PFNGLPROGRAMUNIFORMMATRIX4FVPROC ProgramUniformMatrix4fv;
+			PFNGLPROGRAMUNIFORM1IVPROC ProgramUniform1iv;
+
+			PFNGLGENFRAMEBUFFERSPROC GenFramebuffers;
+			PFNGLDELETEFRAMEBUFFERSPROC DeleteFramebuffers;
+			PFNGLBINDFRAMEBUFFERPROC BindFramebuffer;
+			PFNGLFRAMEBUFFERTEXTURE2DPROC FramebufferTexture2D;
+			PFNGLBLITFRAMEBUFFERPROC BlitFramebuffer;
+			PFNGLVIEWPORTPROC Viewport;
+			PFNGLCLEARPROC Clear;
+			PFNGLCLEARCOLORPROC ClearColor;
+
+			PFNGLDRAWARRAYSPROC DrawArrays;
+			PFNGLDRAWELEMENTSPROC DrawElements;
+			PFNGLDRAWELEMENTSBASEVERTEXPROC DrawElementsBaseVertex;
+
+			PFNGLFENCESYNCPROC FenceSync;
+			PFNGLCLIENTWAITSYNCPROC ClientWaitSync;
+			PFNGLDELETESYNCPROC DeleteSync;
+			PFNGLFINISHPROC Finish;
+		} original;
+
+		void write(const EOp op, std::initializer_list<int64_t> args, const void* pData = nullptr, const size_t dataSize = 0)
+		{
+			const uint16_t opCode = static_cast<uint16_t>(op);
+			const uint8_t argsCount = static_cast<uint8_t>(args.size());
+			traceFile.write(reinterpret_cast<const char*>(&opCode), sizeof(opCode));
+			traceFile.write(reinterpret_cast<const char*>(&argsCount), sizeof(argsCount));
+			for (const int64_t arg : args)
+			{
+				traceFile.write(reinterpret_cast<const char*>(&arg), sizeof(arg));
+			}
+
+			const uint8_t hasData = pData ? 1 : 0;
+			traceFile.write(reinterpret_cast<const char*>(&hasData), sizeof(hasData));
+			if (pData)
+			{
+				const uint64_t size = dataSize;
+				traceFile.write(reinterpret_cast<const char*>(&size), sizeof(size));
+				traceFile.write(static_cast<const char*>(pData), static_cast<std::streamsize>(dataSize));
+			}
+		}
+
+		int64_t pointerArg(const void* pointer)
+		{
+			return static_cast<int64_t>(reinterpret_cast<uintptr_t>(pointer));
+		}
+
+		int64_t floatArg(const GLfloat value)
+		{
+			int32_t bits = 0;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+
+		void writeNames(const EOp op, const GLsizei count, const GLuint* pNames)
+		{
+			for (GLsizei i = 0; i < count; ++i)
+			{
+				write(op, { pNames[i] });
+			}
+		}
+
+		// bytes the driver reads for an upload of unsigned byte texels
+		size_t textureDataSize(const GLsizei width, const GLsizei height, const GLsizei depth, const GLenum format, const GLenum type)
+		{
+			size_t components = 0;
+			switch (format)
+			{
+			case GL_RED: components = 1; break;
+			case GL_RG: components = 2; break;
+			case GL_RGB: components = 3; break;
+			case GL_RGBA: components = 4; break;
+			default: break;
+			}
+			if (type != GL_UNSIGNED_BYTE || components == 0 || width <= 0 || height <= 0 || depth <= 0)
+			{
+				return 0;
+			}
+
+			const size_t rowSize = static_cast<size_t>(width) * components;
+			const size_t alignedRowSize = (rowSize + unpackAlignment - 1) / unpackAlignment * unpackAlignment;
+			return alignedRowSize * (static_cast<size_t>(height) * depth - 1) + rowSize;
+		}
+
+		void APIENTRY recordGenBuffers(GLsizei n, GLuint* buffers) { original.GenBuffers(n, buffers); writeNames(EOp::GenBuffer, n, buffers); }
+		void APIENTRY recordDeleteBuffers(GLsizei n, const GLuint* buffers) { writeNames(EOp::DeleteBuffer, n, buffers); original.DeleteBuffers(n, buffers); }
+		void APIENTRY recordBindBuffer(GLenum target, GLuint buffer) { write(EOp::BindBuffer, { target, buffer }); original.BindBuffer(target, buffer); }
+		void APIENTRY recordBindBufferBase(GLenum target, GLuint index, GLuint buffer) { write(EOp::BindBufferBase, { target, index, buffer }); original.BindBufferBase(target, index, buffer); }
+
+		void APIENTRY recordBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+		{
+			write(EOp::BufferData, { target, size, usage }, data, static_cast<size_t>(size));
+			original.BufferData(target, size, data, usage);
+		}
+
+		void APIENTRY recordBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+		{
+			write(EOp::BufferSubData, { target, offset, size }, data, static_cast<size_t>(size));
+			original.BufferSubData(target, offset, size, data);
+		}
+
+		void APIENTRY recordBufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags)
+		{
+			write(EOp::BufferStorage, { target, size, flags }, data, static_cast<size_t>(size));
+			original.BufferStorage(target, size, data, flags);
+		}
+
+		void* APIENTRY recordMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+		{
+			write(EOp::MapBufferRange, { target, offset, length, access });
+			return original.MapBufferRange(target, offset, length, access);
+		}
+
+		GLboolean APIENTRY recordUnmapBuffer(GLenum target) { write(EOp::UnmapBuffer, { target }); return original.UnmapBuffer(target); }
+
+		void APIENTRY recordGenVertexArrays(GLsizei n, GLuint* arrays) { original.GenVertexArrays(n, arrays); writeNames(EOp::GenVertexArray, n, arrays); }
+		void APIENTRY recordDeleteVertexArrays(GLsizei n, const GLuint* arrays) { writeNames(EOp::DeleteVertexArray, n, arrays); original.DeleteVertexArrays(n, arrays); }
+		void APIENTRY recordBindVertexArray(GLuint array) { write(EOp::BindVertexArray, { array }); original.BindVertexArray(array); }
+		void APIENTRY recordEnableVertexAttribArray(GLuint index) { write(EOp::EnableVertexAttribArray, { index }); original.EnableVertexAttribArray(index); }
+
+		void APIENTRY recordVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+		{
+			write(EOp::VertexAttribPointer, { index, size, type, normalized, stride, pointerArg(pointer) });
+			original.VertexAttribPointer(index, size, type, normalized, stride, pointer);
+		}
+
+		void APIENTRY recordVertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer)
+		{
+			write(EOp::VertexAttribIPointer, { index, size, type, stride, pointerArg(pointer) });
+			original.VertexAttribIPointer(index, size, type, stride, pointer);
+		}
+
+		void APIENTRY recordGenTextures(GLsizei n, GLuint* textures) { original.GenTextures(n, textures); writeNames(EOp::GenTexture, n, textures); }
+		void APIENTRY recordDeleteTextures(GLsizei n, const GLuint* textures) { writeNames(EOp::DeleteTexture, n, textures); original.DeleteTextures(n, textures); }
+		void APIENTRY recordBindTexture(GLenum target, GLuint texture) { write(EOp::BindTexture, { target, texture }); original.BindTexture(target, texture); }
+		void APIENTRY recordActiveTexture(GLenum texture) { write(EOp::ActiveTexture, { texture }); original.ActiveTexture(texture); }
+		void APIENTRY recordTexParameteri(GLenum target, GLenum pname, GLint param) { write(EOp::TexParameteri, { target, pname, param }); original.TexParameteri(target, pname, param); }
+
+		void APIENTRY recordTexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)
+		{
+			write(EOp::TexStorage2D, { target, levels, internalformat, width, height });
+			original.TexStorage2D(target, levels, internalformat, width, height);
+		}
+
+		void APIENTRY recordTexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels)
+		{
+			write(EOp::TexImage3D, { target, level, internalformat, width, height, depth, border, format, type },
+				  pixels, textureDataSize(width, height, depth, format, type));
+			original.TexImage3D(target, level, internalformat, width, height, depth, border, format, type, pixels);
+		}
+
+		void APIENTRY recordTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels)
+		{
+			write(EOp::TexSubImage3D, { target, level, xoffset, yoffset, zoffset, width, height, depth, format, type },
+				  pixels, textureDataSize(width, height, depth, format, type));
+			original.TexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+		}
+
+		void APIENTRY recordGenerateMipmap(GLenum target) { write(EOp::GenerateMipmap, { target }); original.GenerateMipmap(target); }
+
+		void APIENTRY recordPixelStorei(GLenum pname, GLint param)
+		{
+			if (pname == GL_UNPACK_ALIGNMENT)
+			{
+				unpackAlignment = param;
+			}
+			write(EOp::PixelStorei, { pname, param });
+			original.PixelStorei(pname, param);
+		}
+
+		GLuint APIENTRY recordCreateShader(GLenum type)
+		{
+			const GLuint shader = original.CreateShader(type);
+			write(EOp::CreateShader, { type, shader });
+			return shader;
+		}
+
+		void APIENTRY recordShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)
+		{
+			// replayed as one string
+			std::string source;
+			for (GLsizei i = 0; i < count; ++i)
+			{
+				if (length && length[i] >= 0)
+				{
+					source.append(string[i], static_cast<size_t>(length[i]));
+				}
+				else
+				{
+					source.append(string[i]);
+				}
+			}
+			write(EOp::ShaderSource, { shader }, source.data(), source.size());
+			original.ShaderSource(shader, count, string, length);
+		}
+
+		void APIENTRY recordCompileShader(GLuint shader) { write(EOp::CompileShader, { shader }); original.CompileShader(shader); }
+		void APIENTRY recordAttachShader(GLuint program, GLuint shader) { write(EOp::AttachShader, { program, shader }); original.AttachShader(program, shader); }
+		void APIENTRY recordLinkProgram(GLuint program) { write(EOp::LinkProgram, { program }); original.LinkProgram(program); }
+		void APIENTRY recordDeleteShader(GLuint shader) { write(EOp::DeleteShader, { shader }); original.DeleteShader(shader); }
+
+		GLuint APIENTRY recordCreateProgram()
+		{
+			const GLuint program = original.CreateProgram();
+			write(EOp::CreateProgram, { program });
+			return program;
+		}
+
+		void APIENTRY recordDeleteProgram(GLuint program) { write(EOp::DeleteProgram, { program }); original.DeleteProgram(program); }
+		void APIENTRY recordUseProgram(GLuint program) { write(EOp::UseProgram, { program }); original.UseProgram(program); }
+
+		GLint APIENTRY recordGetUniformLocation(GLuint program, const GLchar* name)
+		{
+			const GLint location = original.GetUniformLocation(program, name);
+			write(EOp::GetUniformLocation, { program, location }, name, std::strlen(name));
+			return location;
+		}
+
+		GLuint APIENTRY recordGetUniformBlockIndex(GLuint program, const GLchar* uniformBlockName)
+		{
+			const GLuint blockIndex = original.GetUniformBlockIndex(program, uniformBlockName);
+			write(EOp::GetUniformBlockIndex, { program, blockIndex }, uniformBlockName, std::strlen(uniformBlockName));
+			return blockIndex;
+		}
+
+		void APIENTRY recordUniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)
+		{
+			write(EOp::UniformBlockBinding, { program, uniformBlockIndex, uniformBlockBinding });
+			original.UniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding);
+		}
+
+		void APIENTRY recordProgramUniform1fv(GLuint program, GLint location, GLsizei count, const GLfloat* value)
+		{
+			write(EOp::ProgramUniform1fv, { program, location, count }, value, count * sizeof(GLfloat));
+			original.ProgramUniform1fv(program, location, count, value);
+		}
+
+		void APIENTRY recordProgramUniform2fv(GLuint program, GLint location, GLsizei count, const GLfloat* value)
+		{
+			write(EOp::ProgramUniform2fv, { program, location, count }, value, 2 * count * sizeof(GLfloat));
+			original.ProgramUniform2fv(program, location, count, value);
+		}
+
+		void APIENTRY recordProgramUniform4fv(GLuint program, GLint location, GLsizei count, const GLfloat* value)
+		{
+			write(EOp::ProgramUniform4fv, { program, location, count }, value, 4 * count * sizeof(GLfloat));
+			original.ProgramUniform4fv(program, location, count, value);
+		}
+
+		void APIENTRY recordProgramUniformMatrix4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+		{
+			write(EOp::ProgramUniformMatrix4fv, { program, location, count, transpose }, value, 16 * count * sizeof(GLfloat));
+			original.ProgramUniformMatrix4fv(program, location, count, transpose, value);
+		}
+
+		void APIENTRY recordProgramUniform1iv(GLuint program, GLint location, GLsizei count, const GLint* value)
+		{
+			write(EOp::ProgramUniform1iv, { program, location, count }, value, count * sizeof(GLint));
+			original.ProgramUniform1iv(program, location, count, value);
+		}
+
+		void APIENTRY recordGenFramebuffers(GLsizei n, GLuint* framebuffers) { original.GenFramebuffers(n, framebuffers); writeNames(EOp::GenFramebuffer, n, framebuffers); }
+		void APIENTRY recordDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) { writeNames(EOp::DeleteFramebuffer, n, framebuffers); original.DeleteFramebuffers(n, framebuffers); }
+		void APIENTRY recordBindFramebuffer(GLenum target, GLuint framebuffer) { write(EOp::BindFramebuffer, { target, framebuffer }); original.BindFramebuffer(target, framebuffer); }
+
+		void APIENTRY recordFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+		{
+			write(EOp::FramebufferTexture2D, { target, attachment, textarget, texture, level });
+			original.FramebufferTexture2D(target, attachment, textarget, texture, level);
+		}
+
+		void APIENTRY recordBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)
+		{
+			write(EOp::BlitFramebuffer, { srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter });
+			original.BlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+		}
+
+		void APIENTRY recordViewport(GLint x, GLint y, GLsizei width, GLsizei height) { write(EOp::Viewport, { x, y, width, height }); original.Viewport(x, y, width, height); }
+		void APIENTRY recordClear(GLbitfield mask) { write(EOp::Clear, { mask }); original.Clear(mask); }
+
+		void APIENTRY recordClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+		{
+			write(EOp::ClearColor, { floatArg(red), floatArg(green), floatArg(blue), floatArg(alpha) });
+			original.ClearColor(red, green, blue, alpha);
+		}
+
+		void APIENTRY recordDrawArrays(GLenum mode, GLint first, GLsizei count) { write(EOp::DrawArrays, { mode, first, count }); original.DrawArrays(mode, first, count); }
+
+		void APIENTRY recordDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+		{
+			write(EOp::DrawElements, { mode, count, type, pointerArg(indices) });
+			original.DrawElements(mode, count, type, indices);
+		}
+
+		void APIENTRY recordDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex)
+		{
+			write(EOp::DrawElementsBaseVertex, { mode, count, type, pointerArg(indices), basevertex });
+			original.DrawElementsBaseVertex(mode, count, type, indices, basevertex);
+		}
+
+		GLsync APIENTRY recordFenceSync(GLenum condition, GLbitfield flags)
+		{
+			const GLsync sync = original.FenceSync(condition, flags);
+			write(EOp::FenceSync, { condition, flags, pointerArg(sync) });
+			return sync;
+		}
+
+		GLenum APIENTRY recordClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+		{
+			write(EOp::ClientWaitSync, { pointerArg(sync), flags, static_cast<int64_t>(timeout) });
+			return original.ClientWaitSync(sync, flags, timeout);
+		}
+
+		void APIENTRY recordDeleteSync(GLsync sync) { write(EOp::DeleteSync, { pointerArg(sync) }); original.DeleteSync(sync); }
+		void APIENTRY recordFinish() { write(EOp::Finish, {}); original.Finish(); }
+
+		template <typename T>
+		void hook(T& entry, T& originalEntry, const T recordingEntry, const bool isInstalling)
+		{
+			if (isInstalling)
+			{
+				originalEntry = entry;
+				entry = recordingEntry;
+			}
+			else
+			{
+				entry = originalEntry;
+			}
+		}
+
+		void setHooks(const bool isInstalling)
+		{
+			hook(glad_glGenBuffers, original.GenBuffers, recordGenBuffers, isInstalling);
+			hook(glad_glDeleteBuffers, original.DeleteBuffers, recordDeleteBuffers, isInstalling);
+			hook(glad_glBindBuffer, original.BindBuffer, recordBindBuffer, isInstalling);
+			hook(glad_glBindBufferBase, original.BindBufferBase, recordBindBufferBase, isInstalling);
+			hook(glad_glBufferData, original.BufferData, recordBufferData, isInstalling);
+			hook(glad_glBufferSubData, original.BufferSubData, recordBufferSubData, isInstalling);
+			hook(glad_glBufferStorage, original.BufferStorage, recordBufferStorage, isInstalling);
+			hook(glad_glMapBufferRange, original.MapBufferRange, recordMapBufferRange, isInstalling);
+			hook(glad_glUnmapBuffer, original.UnmapBuffer, recordUnmapBuffer, isInstalling);
+
+			hook(glad_glGenVertexArrays, original.GenVertexArrays, recordGenVertexArrays, isInstalling);
+			hook(glad_glDeleteVertexArrays, original.DeleteVertexArrays, recordDeleteVertexArrays, isInstalling);
+			hook(glad_glBindVertexArray, original.BindVertexArray, recordBindVertexArray, isInstalling);
+			hook(glad_glEnableVertexAttribArray, original.EnableVertexAttribArray, recordEnableVertexAttribArray, isInstalling);
+			hook(glad_glVertexAttribPointer, original.VertexAttribPointer, recordVertexAttribPointer, isInstalling);
+			hook(glad_glVertexAttribIPointer, original.VertexAttribIPointer, recordVertexAttribIPointer, isInstalling);
+
+			hook(glad_glGenTextures, original.GenTextures, recordGenTextures, isInstalling);
+			hook(glad_glDeleteTextures, original.DeleteTextures, recordDeleteTextures, isInstalling);
+			hook(glad_glBindTexture, original.BindTexture, recordBindTexture, isInstalling);
+			hook(glad_glActiveTexture, original.ActiveTexture, recordActiveTexture, isInstalling);
+			hook(glad_glTexParameteri, original.TexParameteri, recordTexParameteri, isInstalling);
+			hook(glad_glTexStorage2D, original.TexStorage2D, recordTexStorage2D, isInstalling);
+			hook(glad_glTexImage3D, original.TexImage3D, recordTexImage3D, isInstalling);
+			hook(glad_glTexSubImage3D, original.TexSubImage3D, recordTexSubImage3D, isInstalling);
+			hook(glad_glGenerateMipmap, original.GenerateMipmap, recordGenerateMipmap, isInstalling);
+			hook(glad_glPixelStorei, original.PixelStorei, recordPixelStorei, isInstalling);
+
+			hook(glad_glCreateShader, original.CreateShader, recordCreateShader, isInstalling);
+			hook(glad_glShaderSource, original.ShaderSource, recordShaderSource, isInstalling);
+			hook(glad_glCompileShader, original.CompileShader, recordCompileShader, isInstalling);
+			hook(glad_glAttachShader, original.AttachShader, recordAttachShader, isInstalling);
+			hook(glad_glLinkProgram, original.LinkProgram, recordLinkProgram, isInstalling);
+			hook(glad_glDeleteShader, original.DeleteShader, recordDeleteShader, isInstalling);
+			hook(glad_glCreateProgram, original.CreateProgram, recordCreateProgram, isInstalling);
+			hook(glad_glDeleteProgram, original.DeleteProgram, recordDeleteProgram, isInstalling);
+			hook(glad_glUseProgram, original.UseProgram, recordUseProgram, isInstalling);
+			hook(glad_glGetUniformLocation, original.GetUniformLocation, recordGetUniformLocation, isInstalling);
+			hook(glad_glGetUniformBlockIndex, original.GetUniformBlockIndex, recordGetUniformBlockIndex, isInstalling);
+			hook(glad_glUniformBlockBinding, original.UniformBlockBinding, recordUniformBlockBinding, isInstalling);
+			hook(glad_glProgramUniform1fv, original.ProgramUniform1fv, recordProgramUniform1fv, isInstalling);
+			hook(glad_glProgramUniform2fv, original.ProgramUniform2fv, recordProgramUniform2fv, isInstalling);
+			hook(glad_glProgramUniform4fv, original.ProgramUniform4fv, recordProgramUniform4fv, isInstalling);
+			hook(glad_glProgramUniformMatrix4fv, original.ProgramUniformMatrix4fv, recordProgramUniformMatrix4fv, isInstalling);
+			hook(glad_glProgramUniform1iv, original.ProgramUniform1iv, recordProgramUniform1iv, isInstalling);
+
+			hook(glad_glGenFramebuffers, original.GenFramebuffers, recordGenFramebuffers, isInstalling);
+			hook(glad_glDeleteFramebuffers, original.DeleteFramebuffers, recordDeleteFramebuffers, isInstalling);
+			hook(glad_glBindFramebuffer, original.BindFramebuffer, recordBindFramebuffer, isInstalling);
+			hook(glad_glFramebufferTexture2D, original.FramebufferTexture2D, recordFramebufferTexture2D, isInstalling);
+			hook(glad_glBlitFramebuffer, original.BlitFramebuffer, recordBlitFramebuffer, isInstalling);
+			hook(glad_glViewport, original.Viewport, recordViewport, isInstalling);
+			hook(glad_glClear, original.Clear, recordClear, isInstalling);
+			hook(glad_glClearColor, original.ClearColor, recordClearColor, isInstalling);
+
+			hook(glad_glDrawArrays, original.DrawArrays, recordDrawArrays, isInstalling);
+			hook(glad_glDrawElements, original.DrawElements, recordDrawElements, isInstalling);
+			hook(glad_glDrawElementsBaseVertex, original.DrawElementsBaseVertex, recordDrawElementsBaseVertex, isInstalling);
+
+			hook(glad_glFenceSync, original.FenceSync, recordFenceSync, isInstalling);
+			hook(glad_glClientWaitSync, original.ClientWaitSync, recordClientWaitSync, isInstalling);
+			hook(glad_glDeleteSync, original.DeleteSync, recordDeleteSync, isInstalling);
+			hook(glad_glFinish, original.Finish, recordFinish, isInstalling);
+		}
+	}
+
+	bool GLTraceRecorder::start(const std::string& path)
+	{
+		if (m_isRecording)
+		{
+			std::cerr << "A GL trace is already being recorded" << std::endl;
+			return false;
+		}
+
+		traceFile.open(path, std::ios::binary);
+		if (!traceFile.is_open())
+		{
+			std::cerr << "Can't write GL trace: " << path << std::endl;
+			return false;
+		}
+		traceFile.write(GLTrace::MAGIC, sizeof(GLTrace::MAGIC));
+		traceFile.write(reinterpret_cast<const char*>(&GLTrace::VERSION), sizeof(GLTrace::VERSION));
+
+		unpackAlignment = 4;
+		setHooks(true);
+		m_isRecording = true;
+		m_framesCount = 0;
+		return true;
+	}
+
+	void GLTraceRecorder::stop()
+	{
+		if (!m_isRecording)
+		{
+			return;
+		}
+
+		setHooks(false);
+		traceFile.close();
+		m_isRecording = false;
+	}
+
+	void GLTraceRecorder::endFrame()
+	{
+		if (m_isRecording)
+		{
+			write(EOp::FrameEnd, {});
+			++m_framesCount;
+		}
+	}
+
+	void GLTraceRecorder::recordMappedWrite(const GLuint buffer, const GLintptr offset, const GLsizeiptr size, const void* pData)
+	{
+		if (m_isRecording)
+		{
+			write(EOp::MappedWrite, { buffer, offset }, pData, static_cast<size_t>(size));
+		}
+	}
+
+}
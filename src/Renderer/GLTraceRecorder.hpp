@@ -0,0 +1,33 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <string>
+
+namespace Renderer {
+
+	// Writes a GLTrace of every GL call the renderer makes between start()
+	// and stop(). The glad entry points are swapped for recording wrappers,
+	// so no call site changes; queries and reads (glGet*, glReadPixels,
+	// timer queries) pass through unrecorded. Writes through persistent
+	// mappings are invisible to GL and are reported with recordMappedWrite.
+	class GLTraceRecorder {
+	public:
+		// call with a current context, after glad has been loaded
+		static bool start(const std::string& path);
+		static void stop();
+		static bool isRecording() { return m_isRecording; }
+
+		static void endFrame();
+		static unsigned int framesCount() { return m_framesCount; }
+		static void recordMappedWrite(const GLuint buffer, const GLintptr offset, const GLsizeiptr size, const void* pData);
+
+		GLTraceRecorder() = delete;
+		~GLTraceRecorder() = delete;
+
+	private:
+		static bool m_isRecording;
+		static unsigned int m_framesCount;
+	};
+
+}
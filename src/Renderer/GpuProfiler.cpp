@@ -0,0 +1,200 @@
+#include "GpuProfiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace Renderer {
+
+	namespace {
+		const size_t NO_RANGE = static_cast<size_t>(-1);
+	}
+
+	GpuProfiler::GpuProfiler(const unsigned int historyFramesCount) :
+		m_queries(FRAMES_IN_FLIGHT * MAX_QUERIES_PER_FRAME),
+		m_history(std::max(historyFramesCount, 1u))
+	{
+		glGenQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+		m_openRanges.fill(NO_RANGE);
+	}
+
+	GpuProfiler::~GpuProfiler()
+	{
+		glDeleteQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+	}
+
+	void GpuProfiler::beginFrame()
+	{
+		// oldest first, results of a later frame can't be ready before an earlier one
+		for (unsigned int i = 0; i < FRAMES_IN_FLIGHT; ++i)
+		{
+			const size_t frameIndex = (m_currentFrame + i) % FRAMES_IN_FLIGHT;
+			if (m_frames[frameIndex].isPending && !collect(frameIndex))
+			{
+				break;
+			}
+		}
+
+		Frame& frame = m_frames[m_currentFrame];
+		if (frame.isPending)
+		{
+			frame.isPending = false;
+			++m_droppedFramesCount;
+		}
+
+		frame.ranges.clear();
+		m_openRanges.fill(NO_RANGE);
+		glQueryCounter(query(m_currentFrame, 0), GL_TIMESTAMP);
+		frame.usedQueriesCount = 1;
+	}
+
+	void GpuProfiler::endFrame()
+	{
+		Frame& frame = m_frames[m_currentFrame];
+		glQueryCounter(query(m_currentFrame, frame.usedQueriesCount), GL_TIMESTAMP);
+		++frame.usedQueriesCount;
+		frame.isPending = true;
+
+		m_currentFrame = (m_currentFrame + 1) % FRAMES_IN_FLIGHT;
+	}
+
+	void GpuProfiler::beginPass(const EPass pass)
+	{
+		Frame& frame = m_frames[m_currentFrame];
+		// keep room for this pass's end and the end of the frame
+		if (frame.usedQueriesCount + 3 > MAX_QUERIES_PER_FRAME)
+		{
+			std::cerr << "Too many GPU profiler ranges in a frame, " << passName(pass) << " is not timed" << std::endl;
+			return;
+		}
+
+		glQueryCounter(query(m_currentFrame, frame.usedQueriesCount), GL_TIMESTAMP);
+		m_openRanges[static_cast<size_t>(pass)] = frame.usedQueriesCount;
+		++frame.usedQueriesCount;
+	}
+
+	void GpuProfiler::endPass(const EPass pass)
+	{
+		size_t& beginQuery = m_openRanges[static_cast<size_t>(pass)];
+		if (beginQuery == NO_RANGE)
+		{
+			return;
+		}
+
+		Frame& frame = m_frames[m_currentFrame];
+		glQueryCounter(query(m_currentFrame, frame.usedQueriesCount), GL_TIMESTAMP);
+		frame.ranges.push_back(Range{ pass, beginQuery, frame.usedQueriesCount });
+		++frame.usedQueriesCount;
+		beginQuery = NO_RANGE;
+	}
+
+	bool GpuProfiler::collect(const size_t frameIndex)
+	{
+		Frame& frame = m_frames[frameIndex];
+
+		// timestamps complete in order, the last one being ready means all are
+		GLuint isAvailable = GL_FALSE;
+		glGetQueryObjectuiv(query(frameIndex, frame.usedQueriesCount - 1), GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+		if (!isAvailable)
+		{
+			return false;
+		}
+
+		std::vector<GLuint64> timestamps(frame.usedQueriesCount);
+		for (size_t i = 0; i < timestamps.size(); ++i)
+		{
+			glGetQueryObjectui64v(query(frameIndex, i), GL_QUERY_RESULT, &timestamps[i]);
+		}
+
+		FrameTimes& times = m_history[m_historyNext];
+		times.fill(0.0);
+		for (const Range& range : frame.ranges)
+		{
+			times[static_cast<size_t>(range.pass)] += (timestamps[range.endQuery] - timestamps[range.beginQuery]) * 1e-6;
+		}
+		times[PASSES_COUNT] = (timestamps.back() - timestamps.front()) * 1e-6;
+
+		m_historyNext = (m_historyNext + 1) % m_history.size();
+		m_historySize = std::min(m_historySize + 1, m_history.size());
+		++m_collectedFramesCount;
+		frame.isPending = false;
+		return true;
+	}
+
+	GpuProfiler::PassTiming GpuProfiler::timing(const size_t column) const
+	{
+		PassTiming timing;
+		if (m_historySize == 0)
+		{
+			return timing;
+		}
+
+		for (size_t i = 0; i < m_historySize; ++i)
+		{
+			timing.averageTime += m_history[i][column];
+			timing.maxTime = std::max(timing.maxTime, m_history[i][column]);
+		}
+		timing.averageTime /= m_historySize;
+		return timing;
+	}
+
+	GpuProfiler::PassTiming GpuProfiler::passTiming(const EPass pass) const
+	{
+		return timing(static_cast<size_t>(pass));
+	}
+
+	GpuProfiler::PassTiming GpuProfiler::frameTiming() const
+	{
+		return timing(PASSES_COUNT);
+	}
+
+	bool GpuProfiler::writeCsv(const std::string& path) const
+	{
+		std::ofstream file(path);
+		if (!file.is_open())
+		{
+			std::cerr << "Can't write GPU profile: " << path << std::endl;
+			return false;
+		}
+
+		file << "frame";
+		for (size_t pass = 0; pass < PASSES_COUNT; ++pass)
+		{
+			file << "," << passName(static_cast<EPass>(pass)) << "_ms";
+		}
+		file << ",Frame_ms\n";
+
+		// the oldest entry is at m_historyNext once the history has wrapped
+		const size_t first = m_historySize < m_history.size() ? 0 : m_historyNext;
+		const uint64_t firstFrameNumber = m_collectedFramesCount - m_historySize;
+		for (size_t i = 0; i < m_historySize; ++i)
+		{
+			const FrameTimes& times = m_history[(first + i) % m_history.size()];
+			file << firstFrameNumber + i;
+			for (const double time : times)
+			{
+				file << "," << time;
+			}
+			file << "\n";
+		}
+		return true;
+	}
+
+	const char* GpuProfiler::passName(const EPass pass)
+	{
+		switch (pass)
+		{
+		case EPass::Map:
+			return "Map";
+		case EPass::Sprites:
+			return "Sprites";
+		case EPass::HUD:
+			return "HUD";
+		case EPass::Upscale:
+			return "Upscale";
+		default:
+			return "Unknown";
+		}
+	}
+
+}
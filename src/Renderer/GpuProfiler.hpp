@@ -0,0 +1,96 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Renderer {
+
+	// GPU time of the render passes of a frame. Every begin/end pair puts two
+	// GL_TIMESTAMP queries in the stream; queries come from a ring of frames
+	// and a frame is read back only once its last query is available, so the
+	// CPU never waits for the GPU. A pass may be entered several times per
+	// frame, its ranges are summed. Results are kept for the last
+	// historyFramesCount frames read back.
+	class GpuProfiler {
+	public:
+		enum class EPass {
+			Map,
+			Sprites,
+			HUD,
+			Upscale,
+			Count
+		};
+
+		static constexpr size_t PASSES_COUNT = static_cast<size_t>(EPass::Count);
+
+		struct PassTiming {
+			double averageTime = 0.0;
+			double maxTime = 0.0;
+		};
+
+		GpuProfiler(const unsigned int historyFramesCount = 120);
+		~GpuProfiler();
+
+		GpuProfiler(const GpuProfiler&) = delete;
+		GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+		void beginFrame();
+		void endFrame();
+		void beginPass(const EPass pass);
+		void endPass(const EPass pass);
+
+		// in ms over the frames in the history
+		PassTiming passTiming(const EPass pass) const;
+		// first begin to last end of the frame
+		PassTiming frameTiming() const;
+		size_t historyFramesCount() const { return m_historySize; }
+		// frames whose queries were still pending when their slot came round again
+		size_t droppedFramesCount() const { return m_droppedFramesCount; }
+
+		// one row per frame in the history, oldest first, times in ms
+		bool writeCsv(const std::string& path) const;
+
+		static const char* passName(const EPass pass);
+
+	private:
+		// all passes followed by the whole frame
+		using FrameTimes = std::array<double, PASSES_COUNT + 1>;
+
+		struct Range {
+			EPass pass;
+			size_t beginQuery;
+			size_t endQuery;
+		};
+
+		struct Frame {
+			std::vector<Range> ranges;
+			size_t usedQueriesCount = 0;
+			bool isPending = false;
+		};
+
+		static constexpr unsigned int FRAMES_IN_FLIGHT = 4;
+		static constexpr size_t MAX_QUERIES_PER_FRAME = 64;
+
+		GLuint query(const size_t frame, const size_t index) const { return m_queries[frame * MAX_QUERIES_PER_FRAME + index]; }
+		// false while the frame's results aren't available yet
+		bool collect(const size_t frameIndex);
+		PassTiming timing(const size_t column) const;
+
+		std::vector<GLuint> m_queries;
+		std::array<Frame, FRAMES_IN_FLIGHT> m_frames;
+		unsigned int m_currentFrame = 0;
+		std::array<size_t, PASSES_COUNT> m_openRanges;
+
+		std::vector<FrameTimes> m_history;
+		size_t m_historyNext = 0;
+		size_t m_historySize = 0;
+		uint64_t m_collectedFramesCount = 0;
+		size_t m_droppedFramesCount = 0;
+	};
+
+}
@@ -0,0 +1,95 @@
+#include "HeadlessContext.hpp"
+
+#include <glad/glad.h>
+#include <EGL/eglext.h>
+
+#include <iostream>
+
+namespace Renderer {
+
+	HeadlessContext::~HeadlessContext()
+	{
+		if (m_display == EGL_NO_DISPLAY)
+		{
+			return;
+		}
+		eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (m_context != EGL_NO_CONTEXT)
+		{
+			eglDestroyContext(m_display, m_context);
+		}
+		eglTerminate(m_display);
+	}
+
+	bool HeadlessContext::init()
+	{
+		auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+		if (getPlatformDisplay)
+		{
+			m_display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+		}
+		if (m_display == EGL_NO_DISPLAY)
+		{
+			m_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		}
+
+		EGLint major = 0;
+		EGLint minor = 0;
+		if (m_display == EGL_NO_DISPLAY || !eglInitialize(m_display, &major, &minor))
+		{
+			std::cerr << "Can't initialize EGL display" << std::endl;
+			m_display = EGL_NO_DISPLAY;
+			return false;
+		}
+
+		if (!eglBindAPI(EGL_OPENGL_API))
+		{
+			std::cerr << "EGL has no desktop OpenGL support" << std::endl;
+			return false;
+		}
+
+		const EGLint contextAttributes[] = {
+			EGL_CONTEXT_MAJOR_VERSION, 4,
+			EGL_CONTEXT_MINOR_VERSION, 5,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE
+		};
+		m_context = eglCreateContext(m_display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttributes);
+		if (m_context == EGL_NO_CONTEXT)
+		{
+			std::cerr << "Can't create EGL OpenGL 4.5 core context" << std::endl;
+			return false;
+		}
+
+		if (!eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_context))
+		{
+			std::cerr << "Can't make the surfaceless EGL context current" << std::endl;
+			return false;
+		}
+
+		if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress)))
+		{
+			std::cerr << "Can't load GLAD!" << std::endl;
+			return false;
+		}
+
+		std::cout << "EGL version: " << major << "." << minor << std::endl;
+		return true;
+	}
+
+	bool HeadlessContext::makeCurrent()
+	{
+		if (!eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_context))
+		{
+			std::cerr << "Can't make the surfaceless EGL context current" << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	void HeadlessContext::release()
+	{
+		eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	}
+
+}
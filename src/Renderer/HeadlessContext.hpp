@@ -0,0 +1,29 @@
+#pragma once
+
+#include <EGL/egl.h>
+
+namespace Renderer {
+
+	// GL 4.5 core context without a window or display server, through EGL on
+	// the Mesa surfaceless platform (llvmpipe when there is no GPU). There is
+	// no default framebuffer: render into a FrameBuffer.
+	class HeadlessContext {
+	public:
+		HeadlessContext() = default;
+		~HeadlessContext();
+
+		HeadlessContext(const HeadlessContext&) = delete;
+		HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+		// creates the context, makes it current and loads GL functions
+		bool init();
+		// moves the context between threads: release on one, make current on the other
+		bool makeCurrent();
+		void release();
+
+	private:
+		EGLDisplay m_display = EGL_NO_DISPLAY;
+		EGLContext m_context = EGL_NO_CONTEXT;
+	};
+
+}
@@ -0,0 +1,388 @@
+#include "NullBackend.hpp"
+
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace Renderer {
+
+	namespace {
+		bool uniformType(const std::string& typeName, GLenum& type)
+		{
+			static const std::unordered_map<std::string, GLenum> types = {
+				{ "int", GL_INT },
+				{ "bool", GL_BOOL },
+				{ "float", GL_FLOAT },
+				{ "vec2", GL_FLOAT_VEC2 },
+				{ "vec4", GL_FLOAT_VEC4 },
+				{ "mat4", GL_FLOAT_MAT4 },
+				{ "sampler2D", GL_SAMPLER_2D },
+				{ "sampler2DArray", GL_SAMPLER_2D_ARRAY }
+			};
+			auto it = types.find(typeName);
+			if (it == types.end())
+			{
+				return false;
+			}
+			type = it->second;
+			return true;
+		}
+
+		// "uniform <type> <name>;" declarations outside of blocks
+		void parseUniforms(const std::string& source, std::vector<RenderBackend::UniformDescription>& uniforms)
+		{
+			std::istringstream stream(source);
+			std::string line;
+			while (std::getline(stream, line))
+			{
+				std::istringstream words(line);
+				std::string qualifier;
+				std::string typeName;
+				std::string name;
+				GLenum type = 0;
+				if (!(words >> qualifier >> typeName >> name) || qualifier != "uniform" || !uniformType(typeName, type))
+				{
+					continue;
+				}
+
+				name = name.substr(0, name.find_first_of(";["));
+				for (const auto& uniform : uniforms)
+				{
+					if (uniform.name == name)
+					{
+						type = 0;
+					}
+				}
+				if (type != 0)
+				{
+					uniforms.push_back(RenderBackend::UniformDescription{ name, static_cast<GLint>(uniforms.size()), type });
+				}
+			}
+		}
+
+		// every call into a no-op entry point
+		size_t glCallsCount = 0;
+		GLuint lastName = 0;
+		// the mapped stream buffers need memory behind them
+		std::unordered_map<GLenum, GLuint> boundBuffers;
+		std::unordered_map<GLuint, std::vector<unsigned char>> buffersData;
+		int fence = 0;
+
+		void genNames(const GLsizei count, GLuint* pNames)
+		{
+			++glCallsCount;
+			for (GLsizei i = 0; i < count; ++i)
+			{
+				pNames[i] = ++lastName;
+			}
+		}
+
+		void deleteBuffers(const GLsizei count, const GLuint* pNames)
+		{
+			++glCallsCount;
+			for (GLsizei i = 0; i < count; ++i)
+			{
+				buffersData.erase(pNames[i]);
+			}
+		}
+
+		void resizeBoundBuffer(const GLenum target, const GLsizeiptr size)
+		{
+			++glCallsCount;
+			buffersData[boundBuffers[target]].resize(static_cast<size_t>(size));
+		}
+
+		void APIENTRY nullGenBuffers(GLsizei n, GLuint* buffers) { genNames(n, buffers); }
+		void APIENTRY nullDeleteBuffers(GLsizei n, const GLuint* buffers) { deleteBuffers(n, buffers); }
+		void APIENTRY nullBindBuffer(GLenum target, GLuint buffer) { ++glCallsCount; boundBuffers[target] = buffer; }
+		void APIENTRY nullBindBufferBase(GLenum target, GLuint, GLuint buffer) { ++glCallsCount; boundBuffers[target] = buffer; }
+		void APIENTRY nullBufferData(GLenum target, GLsizeiptr size, const void*, GLenum) { resizeBoundBuffer(target, size); }
+		void APIENTRY nullBufferSubData(GLenum, GLintptr, GLsizeiptr, const void*) { ++glCallsCount; }
+		void APIENTRY nullBufferStorage(GLenum target, GLsizeiptr size, const void*, GLbitfield) { resizeBoundBuffer(target, size); }
+		void* APIENTRY nullMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr, GLbitfield) { ++glCallsCount; return buffersData[boundBuffers[target]].data() + offset; }
+		GLboolean APIENTRY nullUnmapBuffer(GLenum) { ++glCallsCount; return GL_TRUE; }
+
+		void APIENTRY nullGenVertexArrays(GLsizei n, GLuint* arrays) { genNames(n, arrays); }
+		void APIENTRY nullDeleteVertexArrays(GLsizei, const GLuint*) { ++glCallsCount; }
+		void APIENTRY nullBindVertexArray(GLuint) { ++glCallsCount; }
+		void APIENTRY nullEnableVertexAttribArray(GLuint) { ++glCallsCount; }
+		void APIENTRY nullVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) { ++glCallsCount; }
+		void APIENTRY nullVertexAttribIPointer(GLuint, GLint, GLenum, GLsizei, const void*) { ++glCallsCount; }
+
+		void APIENTRY nullGenTextures(GLsizei n, GLuint* textures) { genNames(n, textures); }
+		void APIENTRY nullDeleteTextures(GLsizei, const GLuint*) { ++glCallsCount; }
+		void APIENTRY nullBindTexture(GLenum, GLuint) { ++glCallsCount; }
+		void APIENTRY nullActiveTexture(GLenum) { ++glCallsCount; }
+		void APIENTRY nullTexParameteri(GLenum, GLenum, GLint) { ++glCallsCount; }
+		void APIENTRY nullTexStorage2D(GLenum, GLsizei, GLenum, GLsizei, GLsizei) { ++glCallsCount; }
+		void APIENTRY nullTexImage3D(GLenum, GLint, GLint, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*) { ++glCallsCount; }
+		void APIENTRY nullTexSubImage3D(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const void*) { ++glCallsCount; }
+		void APIENTRY nullGenerateMipmap(GLenum) { ++glCallsCount; }
+		void APIENTRY nullPixelStorei(GLenum, GLint) { ++glCallsCount; }
+
+		GLuint APIENTRY nullCreateShader(GLenum) { ++glCallsCount; return ++lastName; }
+		void APIENTRY nullShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) { ++glCallsCount; }
+		void APIENTRY nullCompileShader(GLuint) { ++glCallsCount; }
+		void APIENTRY nullGetShaderiv(GLuint, GLenum pname, GLint* params) { ++glCallsCount; *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0; }
+		void APIENTRY nullGetShaderInfoLog(GLuint, GLsizei, GLsizei* length, GLchar* infoLog) { ++glCallsCount; if (length) *length = 0; *infoLog = '\0'; }
+		void APIENTRY nullAttachShader(GLuint, GLuint) { ++glCallsCount; }
+		void APIENTRY nullLinkProgram(GLuint) { ++glCallsCount; }
+		void APIENTRY nullGetProgramiv(GLuint, GLenum pname, GLint* params) { ++glCallsCount; *params = pname == GL_LINK_STATUS ? GL_TRUE : 0; }
+		void APIENTRY nullGetProgramInfoLog(GLuint, GLsizei, GLsizei* length, GLchar* infoLog) { ++glCallsCount; if (length) *length = 0; *infoLog = '\0'; }
+		void APIENTRY nullProgramParameteri(GLuint, GLenum, GLint) { ++glCallsCount; }
+		void APIENTRY nullDeleteShader(GLuint) { ++glCallsCount; }
+		GLuint APIENTRY nullCreateProgram() { ++glCallsCount; return ++lastName; }
+		void APIENTRY nullDeleteProgram(GLuint) { ++glCallsCount; }
+		void APIENTRY nullUseProgram(GLuint) { ++glCallsCount; }
+		GLint APIENTRY nullGetUniformLocation(GLuint, const GLchar*) { ++glCallsCount; return -1; }
+		GLuint APIENTRY nullGetUniformBlockIndex(GLuint, const GLchar*) { ++glCallsCount; return 0; }
+		void APIENTRY nullUniformBlockBinding(GLuint, GLuint, GLuint) { ++glCallsCount; }
+		void APIENTRY nullProgramUniform1fv(GLuint, GLint, GLsizei, const GLfloat*) { ++glCallsCount; }
+		void APIENTRY nullProgramUniform2fv(GLuint, GLint, GLsizei, const GLfloat*) { ++glCallsCount; }
+		void APIENTRY nullProgramUniform4fv(GLuint, GLint, GLsizei, const GLfloat*) { ++glCallsCount; }
+		void APIENTRY nullProgramUniformMatrix4fv(GLuint, GLint, GLsizei, GLboolean, const GLfloat*) { ++glCallsCount; }
+		void APIENTRY nullProgramUniform1iv(GLuint, GLint, GLsizei, const GLint*) { ++glCallsCount; }
+
+		void APIENTRY nullGenFramebuffers(GLsizei n, GLuint* framebuffers) { genNames(n, framebuffers); }
+		void APIENTRY nullDeleteFramebuffers(GLsizei, const GLuint*) { ++glCallsCount; }
+		void APIENTRY nullBindFramebuffer(GLenum, GLuint) { ++glCallsCount; }
+		void APIENTRY nullFramebufferTexture2D(GLenum, GLenum, GLenum, GLuint, GLint) { ++glCallsCount; }
+		GLenum APIENTRY nullCheckFramebufferStatus(GLenum) { ++glCallsCount; return GL_FRAMEBUFFER_COMPLETE; }
+		void APIENTRY nullBlitFramebuffer(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum) { ++glCallsCount; }
+		void APIENTRY nullViewport(GLint, GLint, GLsizei, GLsizei) { ++glCallsCount; }
+		void APIENTRY nullClear(GLbitfield) { ++glCallsCount; }
+		void APIENTRY nullClearColor(GLfloat, GLfloat, GLfloat, GLfloat) { ++glCallsCount; }
+
+		void APIENTRY nullDrawArrays(GLenum, GLint, GLsizei) { ++glCallsCount; }
+		void APIENTRY nullDrawElements(GLenum, GLsizei, GLenum, const void*) { ++glCallsCount; }
+		void APIENTRY nullDrawElementsBaseVertex(GLenum, GLsizei, GLenum, const void*, GLint) { ++glCallsCount; }
+
+		GLsync APIENTRY nullFenceSync(GLenum, GLbitfield) { ++glCallsCount; return reinterpret_cast<GLsync>(&fence); }
+		GLenum APIENTRY nullClientWaitSync(GLsync, GLbitfield, GLuint64) { ++glCallsCount; return GL_ALREADY_SIGNALED; }
+		void APIENTRY nullDeleteSync(GLsync) { ++glCallsCount; }
+		void APIENTRY nullFinish() { ++glCallsCount; }
+
+		// every query is available at once and measures no time
+		void APIENTRY nullGenQueries(GLsizei n, GLuint* ids) { genNames(n, ids); }
+		void APIENTRY nullDeleteQueries(GLsizei, const GLuint*) { ++glCallsCount; }
+		void APIENTRY nullQueryCounter(GLuint, GLenum) { ++glCallsCount; }
+		void APIENTRY nullGetQueryObjectuiv(GLuint, GLenum, GLuint* params) { ++glCallsCount; *params = GL_TRUE; }
+		void APIENTRY nullGetQueryObjectui64v(GLuint, GLenum, GLuint64* params) { ++glCallsCount; *params = 0; }
+
+		GLenum APIENTRY nullGetError() { return GL_NO_ERROR; }
+		void APIENTRY nullGetIntegerv(GLenum, GLint* data) { ++glCallsCount; *data = 0; }
+		const GLubyte* APIENTRY nullGetString(GLenum) { return reinterpret_cast<const GLubyte*>("Null"); }
+
+		// swapped with glad's, so swapping twice restores them
+		struct Entries {
+			PFNGLGENBUFFERSPROC GenBuffers = nullGenBuffers;
+			PFNGLDELETEBUFFERSPROC DeleteBuffers = nullDeleteBuffers;
+			PFNGLBINDBUFFERPROC BindBuffer = nullBindBuffer;
+			PFNGLBINDBUFFERBASEPROC BindBufferBase = nullBindBufferBase;
+			PFNGLBUFFERDATAPROC BufferData = nullBufferData;
+			PFNGLBUFFERSUBDATAPROC BufferSubData = nullBufferSubData;
+			PFNGLBUFFERSTORAGEPROC BufferStorage = nullBufferStorage;
+			PFNGLMAPBUFFERRANGEPROC MapBufferRange = nullMapBufferRange;
+			PFNGLUNMAPBUFFERPROC UnmapBuffer = nullUnmapBuffer;
+
+			PFNGLGENVERTEXARRAYSPROC GenVertexArrays = nullGenVertexArrays;
+			PFNGLDELETEVERTEXARRAYSPROC DeleteVertexArrays = nullDeleteVertexArrays;
+			PFNGLBINDVERTEXARRAYPROC BindVertexArray = nullBindVertexArray;
+			PFNGLENABLEVERTEXATTRIBARRAYPROC EnableVertexAttribArray = nullEnableVertexAttribArray;
+			PFNGLVERTEXATTRIBPOINTERPROC VertexAttribPointer = nullVertexAttribPointer;
+			PFNGLVERTEXATTRIBIPOINTERPROC VertexAttribIPointer = nullVertexAttribIPointer;
+
+			PFNGLGENTEXTURESPROC GenTextures = nullGenTextures;
+			PFNGLDELETETEXTURESPROC DeleteTextures = nullDeleteTextures;
+			PFNGLBINDTEXTUREPROC BindTexture = nullBindTexture;
+			PFNGLACTIVETEXTUREPROC ActiveTexture = nullActiveTexture;
+			PFNGLTEXPARAMETERIPROC TexParameteri = nullTexParameteri;
+			PFNGLTEXSTORAGE2DPROC TexStorage2D = nullTexStorage2D;
+			PFNGLTEXIMAGE3DPROC TexImage3D = nullTexImage3D;
+			PFNGLTEXSUBIMAGE3DPROC TexSubImage3D = nullTexSubImage3D;
+			PFNGLGENERATEMIPMAPPROC GenerateMipmap = nullGenerateMipmap;
+			PFNGLPIXELSTOREIPROC PixelStorei = nullPixelStorei;
+
+			PFNGLCREATESHADERPROC CreateShader = nullCreateShader;
+			PFNGLSHADERSOURCEPROC ShaderSource = nullShaderSource;
+			PFNGLCOMPILESHADERPROC CompileShader = nullCompileShader;
+			PFNGLGETSHADERIVPROC GetShaderiv = nullGetShaderiv;
+			PFNGLGETSHADERINFOLOGPROC GetShaderInfoLog = nullGetShaderInfoLog;
+			PFNGLATTACHSHADERPROC AttachShader = nullAttachShader;
+			PFNGLLINKPROGRAMPROC LinkProgram = nullLinkProgram;
+			PFNGLGETPROGRAMIVPROC GetProgramiv = nullGetProgramiv;
+			PFNGLGETPROGRAMINFOLOGPROC GetProgramInfoLog = nullGetProgramInfoLog;
+			PFNGLPROGRAMPARAMETERIPROC ProgramParameteri = nullProgramParameteri;
+			PFNGLDELETESHADERPROC DeleteShader = nullDeleteShader;
+			PFNGLCREATEPROGRAMPROC CreateProgram = nullCreateProgram;
+			PFNGLDELETEPROGRAMPROC DeleteProgram = nullDeleteProgram;
+			PFNGLUSEPROGRAMPROC UseProgram = nullUseProgram;
+			PFNGLGETUNIFORMLOCATIONPROC GetUniformLocation = nullGetUniformLocation;
+			PFNGLGETUNIFORMBLOCKINDEXPROC GetUniformBlockIndex = nullGetUniformBlockIndex;
+			PFNGLUNIFORMBLOCKBINDINGPROC UniformBlockBinding = nullUniformBlockBinding;
+			PFNGLPROGRAMUNIFORM1FVPROC ProgramUniform1fv = nullProgramUniform1fv;
+			PFNGLPROGRAMUNIFORM2FVPROC ProgramUniform2fv = nullProgramUniform2fv;
+			PFNGLPROGRAMUNIFORM4FVPROC ProgramUniform4fv = nullProgramUniform4fv;
+			PFNGLPROGRAMUNIFORMMATRIX4FVPROC ProgramUniformMatrix4fv = nullProgramUniformMatrix4fv;
+			PFNGLPROGRAMUNIFORM1IVPROC ProgramUniform1iv = nullProgramUniform1iv;
+
+			PFNGLGENFRAMEBUFFERSPROC GenFramebuffers = nullGenFramebuffers;
+			PFNGLDELETEFRAMEBUFFERSPROC DeleteFramebuffers = nullDeleteFramebuffers;
+			PFNGLBINDFRAMEBUFFERPROC BindFramebuffer = nullBindFramebuffer;
+			PFNGLFRAMEBUFFERTEXTURE2DPROC FramebufferTexture2D = nullFramebufferTexture2D;
+			PFNGLCHECKFRAMEBUFFERSTATUSPROC CheckFramebufferStatus = nullCheckFramebufferStatus;
+			PFNGLBLITFRAMEBUFFERPROC BlitFramebuffer = nullBlitFramebuffer;
+			PFNGLVIEWPORTPROC Viewport = nullViewport;
+			PFNGLCLEARPROC Clear = nullClear;
+			PFNGLCLEARCOLORPROC ClearColor = nullClearColor;
+
+			PFNGLDRAWARRAYSPROC DrawArrays = nullDrawArrays;
+			PFNGLDRAWELEMENTSPROC DrawElements = nullDrawElements;
+			PFNGLDRAWELEMENTSBASEVERTEXPROC DrawElementsBaseVertex = nullDrawElementsBaseVertex;
+
+			PFNGLFENCESYNCPROC FenceSync = nullFenceSync;
+			PFNGLCLIENTWAITSYNCPROC ClientWaitSync = nullClientWaitSync;
+			PFNGLDELETESYNCPROC DeleteSync = nullDeleteSync;
+			PFNGLFINISHPROC Finish = nullFinish;
+
+			PFNGLGENQUERIESPROC GenQueries = nullGenQueries;
+			PFNGLDELETEQUERIESPROC DeleteQueries = nullDeleteQueries;
+			PFNGLQUERYCOUNTERPROC QueryCounter = nullQueryCounter;
+			PFNGLGETQUERYOBJECTUIVPROC GetQueryObjectuiv = nullGetQueryObjectuiv;
+			PFNGLGETQUERYOBJECTUI64VPROC GetQueryObjectui64v = nullGetQueryObjectui64v;
+
+			PFNGLGETERRORPROC GetError = nullGetError;
+			PFNGLGETINTEGERVPROC GetIntegerv = nullGetIntegerv;
+			PFNGLGETSTRINGPROC GetString = nullGetString;
+		} entries;
+
+		void swapEntries()
+		{
+			std::swap(glad_glGenBuffers, entries.GenBuffers);
+			std::swap(glad_glDeleteBuffers, entries.DeleteBuffers);
+			std::swap(glad_glBindBuffer, entries.BindBuffer);
+			std::swap(glad_glBindBufferBase, entries.BindBufferBase);
+			std::swap(glad_glBufferData, entries.BufferData);
+			std::swap(glad_glBufferSubData, entries.BufferSubData);
+			std::swap(glad_glBufferStorage, entries.BufferStorage);
+			std::swap(glad_glMapBufferRange, entries.MapBufferRange);
+			std::swap(glad_glUnmapBuffer, entries.UnmapBuffer);
+
+			std::swap(glad_glGenVertexArrays, entries.GenVertexArrays);
+			std::swap(glad_glDeleteVertexArrays, entries.DeleteVertexArrays);
+			std::swap(glad_glBindVertexArray, entries.BindVertexArray);
+			std::swap(glad_glEnableVertexAttribArray, entries.EnableVertexAttribArray);
+			std::swap(glad_glVertexAttribPointer, entries.VertexAttribPointer);
+			std::swap(glad_glVertexAttribIPointer, entries.VertexAttribIPointer);
+
+			std::swap(glad_glGenTextures, entries.GenTextures);
+			std::swap(glad_glDeleteTextures, entries.DeleteTextures);
+			std::swap(glad_glBindTexture, entries.BindTexture);
+			std::swap(glad_glActiveTexture, entries.ActiveTexture);
+			std::swap(glad_glTexParameteri, entries.TexParameteri);
+			std::swap(glad_glTexStorage2D, entries.TexStorage2D);
+			std::swap(glad_glTexImage3D, entries.TexImage3D);
+			std::swap(glad_glTexSubImage3D, entries.TexSubImage3D);
+			std::swap(glad_glGenerateMipmap, entries.GenerateMipmap);
+			std::swap(glad_glPixelStorei, entries.PixelStorei);
+
+			std::swap(glad_glCreateShader, entries.CreateShader);
+			std::swap(glad_glShaderSource, entries.ShaderSource);
+			std::swap(glad_glCompileShader, entries.CompileShader);
+			std::swap(glad_glGetShaderiv, entries.GetShaderiv);
+			std::swap(glad_glGetShaderInfoLog, entries.GetShaderInfoLog);
+			std::swap(glad_glAttachShader, entries.AttachShader);
+			std::swap(glad_glLinkProgram, entries.LinkProgram);
+			std::swap(glad_glGetProgramiv, entries.GetProgramiv);
+			std::swap(glad_glGetProgramInfoLog, entries.GetProgramInfoLog);
+			std::swap(glad_glProgramParameteri, entries.ProgramParameteri);
+			std::swap(glad_glDeleteShader, entries.DeleteShader);
+			std::swap(glad_glCreateProgram, entries.CreateProgram);
+			std::swap(glad_glDeleteProgram, entries.DeleteProgram);
+			std::swap(glad_glUseProgram, entries.UseProgram);
+			std::swap(glad_glGetUniformLocation, entries.GetUniformLocation);
+			std::swap(glad_glGetUniformBlockIndex, entries.GetUniformBlockIndex);
+			std::swap(glad_glUniformBlockBinding, entries.UniformBlockBinding);
+			std::swap(glad_glProgramUniform1fv, entries.ProgramUniform1fv);
+			std::swap(glad_glProgramUniform2fv, entries.ProgramUniform2fv);
+			std::swap(glad_glProgramUniform4fv, entries.ProgramUniform4fv);
+			std::swap(glad_glProgramUniformMatrix4fv, entries.ProgramUniformMatrix4fv);
+			std::swap(glad_glProgramUniform1iv, entries.ProgramUniform1iv);
+
+			std::swap(glad_glGenFramebuffers, entries.GenFramebuffers);
+			std::swap(glad_glDeleteFramebuffers, entries.DeleteFramebuffers);
+			std::swap(glad_glBindFramebuffer, entries.BindFramebuffer);
+			std::swap(glad_glFramebufferTexture2D, entries.FramebufferTexture2D);
+			std::swap(glad_glCheckFramebufferStatus, entries.CheckFramebufferStatus);
+			std::swap(glad_glBlitFramebuffer, entries.BlitFramebuffer);
+			std::swap(glad_glViewport, entries.Viewport);
+			std::swap(glad_glClear, entries.Clear);
+			std::swap(glad_glClearColor, entries.ClearColor);
+
+			std::swap(glad_glDrawArrays, entries.DrawArrays);
+			std::swap(glad_glDrawElements, entries.DrawElements);
+			std::swap(glad_glDrawElementsBaseVertex, entries.DrawElementsBaseVertex);
+
+			std::swap(glad_glFenceSync, entries.FenceSync);
+			std::swap(glad_glClientWaitSync, entries.ClientWaitSync);
+			std::swap(glad_glDeleteSync, entries.DeleteSync);
+			std::swap(glad_glFinish, entries.Finish);
+
+			std::swap(glad_glGenQueries, entries.GenQueries);
+			std::swap(glad_glDeleteQueries, entries.DeleteQueries);
+			std::swap(glad_glQueryCounter, entries.QueryCounter);
+			std::swap(glad_glGetQueryObjectuiv, entries.GetQueryObjectuiv);
+			std::swap(glad_glGetQueryObjectui64v, entries.GetQueryObjectui64v);
+
+			std::swap(glad_glGetError, entries.GetError);
+			std::swap(glad_glGetIntegerv, entries.GetIntegerv);
+			std::swap(glad_glGetString, entries.GetString);
+		}
+	}
+
+	NullBackend::NullBackend()
+	{
+		swapEntries();
+	}
+
+	NullBackend::~NullBackend()
+	{
+		// objects made by the base class go while the no-op entry points are in place
+		releaseResources();
+		swapEntries();
+		boundBuffers.clear();
+		buffersData.clear();
+	}
+
+	GLuint NullBackend::createProgram(const std::string& vertexShader, const std::string& fragmentShader)
+	{
+		const GLuint program = OpenGLBackend::createProgram(vertexShader, fragmentShader);
+		std::vector<UniformDescription>& uniforms = m_programsUniforms[program];
+		parseUniforms(vertexShader, uniforms);
+		parseUniforms(fragmentShader, uniforms);
+		return program;
+	}
+
+	void NullBackend::deleteProgram(const GLuint program)
+	{
+		OpenGLBackend::deleteProgram(program);
+		m_programsUniforms.erase(program);
+	}
+
+	std::vector<RenderBackend::UniformDescription> NullBackend::activeUniforms(const GLuint program)
+	{
+		auto it = m_programsUniforms.find(program);
+		return it != m_programsUniforms.end() ? it->second : std::vector<UniformDescription>();
+	}
+
+	size_t NullBackend::callsCount() const
+	{
+		return glCallsCount;
+	}
+
+	void NullBackend::resetCounters()
+	{
+		glCallsCount = 0;
+	}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "OpenGLBackend.hpp"
+
+#include <cstddef>
+#include <unordered_map>
+
+namespace Renderer {
+
+	// The OpenGL backend on no-op GL entry points, so a frame takes the same
+	// path as on the GPU and RenderStats counts the same draws, binds and
+	// uploads, without driver time and without a GL context. The entry points
+	// are swapped in glad while the backend is alive, the way GLTraceRecorder
+	// hooks them; only one may exist at a time. Programs get their uniforms
+	// from the shader source, so the uniform paths of ShaderProgram still run.
+	class NullBackend : public OpenGLBackend {
+	public:
+		NullBackend();
+		~NullBackend() override;
+
+		NullBackend(const NullBackend&) = delete;
+		NullBackend& operator=(const NullBackend&) = delete;
+
+		EType type() const override { return EType::Null; }
+
+		GLuint createProgram(const std::string& vertexShader, const std::string& fragmentShader) override;
+		void deleteProgram(const GLuint program) override;
+		std::vector<UniformDescription> activeUniforms(const GLuint program) override;
+
+		// GL calls made since the last reset
+		size_t callsCount() const;
+		void resetCounters();
+
+	private:
+		std::unordered_map<GLuint, std::vector<UniformDescription>> m_programsUniforms;
+	};
+
+}
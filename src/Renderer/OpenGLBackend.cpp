@@ -0,0 +1,244 @@
+#include "OpenGLBackend.hpp"
+
+#include "GLStateCache.hpp"
+#include "SpriteQuad.hpp"
+#include "StreamBuffer.hpp"
+#include "SpriteBatch.hpp"
+#include "RenderQueue.hpp"
+#include "RenderStats.hpp"
+#include "ProgramBinaryCache.hpp"
+
+#include <chrono>
+#include <iostream>
+
+namespace Renderer {
+
+	namespace {
+		const GLsizeiptr QUEUE_STREAM_BUFFER_REGION_SIZE = 1 << 20;
+	}
+
+	OpenGLBackend::OpenGLBackend() = default;
+
+	OpenGLBackend::~OpenGLBackend() = default;
+
+	GLuint OpenGLBackend::createTexture(const GLuint width,
+										const GLuint height,
+										const GLenum format,
+										const std::vector<const unsigned char*>& layersData,
+										const GLuint filter,
+										const GLenum wrapMode)
+	{
+		const GLsizei layersCount = static_cast<GLsizei>(layersData.size());
+
+		GLuint texture = 0;
+		glGenTextures(1, &texture);
+		GLStateCache::bindTexture(0, GL_TEXTURE_2D_ARRAY, texture);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, format, width, height, layersCount, 0, format, GL_UNSIGNED_BYTE, nullptr);
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		for (GLsizei layer = 0; layer < layersCount; ++layer)
+		{
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1, format, GL_UNSIGNED_BYTE, layersData[layer]);
+		}
+
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, wrapMode);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, wrapMode);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, filter);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, filter);
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+		GLStateCache::bindTexture(0, GL_TEXTURE_2D_ARRAY, 0);
+		return texture;
+	}
+
+	void OpenGLBackend::deleteTexture(const GLuint texture)
+	{
+		GLStateCache::deleteTexture(texture);
+	}
+
+	void OpenGLBackend::bindTexture(const GLuint unit, const GLuint texture)
+	{
+		GLStateCache::bindTexture(unit, GL_TEXTURE_2D_ARRAY, texture);
+	}
+
+	GLuint OpenGLBackend::createProgram(const std::string& vertexShader, const std::string& fragmentShader)
+	{
+		if (ProgramBinaryCache::isOpen())
+		{
+			if (const GLuint program = ProgramBinaryCache::load(vertexShader, fragmentShader))
+			{
+				return program;
+			}
+		}
+		auto startTime = std::chrono::high_resolution_clock::now();
+
+		GLuint vertexShaderID;
+		if (!createShader(vertexShader, GL_VERTEX_SHADER, vertexShaderID)) {
+			std::cerr << "VERTEX SHADER compile time error" << std::endl;
+			glDeleteShader(vertexShaderID);
+			return 0;
+		}
+
+		GLuint fragmentShaderID;
+		if (!createShader(fragmentShader, GL_FRAGMENT_SHADER, fragmentShaderID)) {
+			std::cerr << "FRAGMENT SHADER compile time error" << std::endl;
+			glDeleteShader(vertexShaderID);
+			glDeleteShader(fragmentShaderID);
+			return 0;
+		}
+
+		GLuint program = glCreateProgram();
+		glAttachShader(program, vertexShaderID);
+		glAttachShader(program, fragmentShaderID);
+		if (ProgramBinaryCache::isOpen())
+		{
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
+		glLinkProgram(program);
+		glDeleteShader(vertexShaderID);
+		glDeleteShader(fragmentShaderID);
+
+		GLint success;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (!success) {
+			GLchar infoLog[1024];
+			glGetProgramInfoLog(program, 1024, nullptr, infoLog);
+			std::cerr << "ERROR::SHADER: Link-time error:\n" << infoLog << std::endl;
+			GLStateCache::deleteProgram(program);
+			return 0;
+		}
+
+		if (ProgramBinaryCache::isOpen())
+		{
+			const double compileTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+			ProgramBinaryCache::store(program, vertexShader, fragmentShader, compileTime);
+		}
+		return program;
+	}
+
+	bool OpenGLBackend::createShader(const std::string& source, const GLenum shaderType, GLuint& shaderID)
+	{
+		shaderID = glCreateShader(shaderType);
+		const char* code = source.c_str();
+		glShaderSource(shaderID, 1, &code, nullptr);
+		glCompileShader(shaderID);
+
+		GLint success;
+		glGetShaderiv(shaderID, GL_COMPILE_STATUS, &success);
+
+		if (!success) {
+			GLchar infoLog[1024];
+			glGetShaderInfoLog(shaderID, 1024, nullptr, infoLog);
+			std::cerr << "ERROR::SHADER: compile time error!\n" << infoLog << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	void OpenGLBackend::deleteProgram(const GLuint program)
+	{
+		GLStateCache::deleteProgram(program);
+	}
+
+	void OpenGLBackend::useProgram(const GLuint program)
+	{
+		GLStateCache::useProgram(program);
+	}
+
+	std::vector<RenderBackend::UniformDescription> OpenGLBackend::activeUniforms(const GLuint program)
+	{
+		GLint uniformsCount = 0;
+		glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformsCount);
+
+		GLint maxNameLength = 0;
+		glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+		std::string name(static_cast<size_t>(maxNameLength), '\0');
+
+		std::vector<UniformDescription> uniforms;
+		for (GLint i = 0; i < uniformsCount; ++i) {
+			GLsizei nameLength = 0;
+			GLint size = 0;
+			GLenum type = 0;
+			glGetActiveUniform(program, static_cast<GLuint>(i), maxNameLength, &nameLength, &size, &type, &name[0]);
+
+			std::string uniformName = name.substr(0, static_cast<size_t>(nameLength));
+			const GLint location = glGetUniformLocation(program, uniformName.c_str());
+			if (location < 0) {
+				// members of uniform blocks have no location
+				continue;
+			}
+
+			// arrays are reported as "name[0]", callers use the plain name
+			const size_t arraySuffix = uniformName.rfind("[0]");
+			if (arraySuffix != std::string::npos && arraySuffix + 3 == uniformName.size()) {
+				uniformName.resize(arraySuffix);
+			}
+
+			uniforms.push_back(UniformDescription{ std::move(uniformName), location, type });
+		}
+		return uniforms;
+	}
+
+	void OpenGLBackend::uploadUniform(const GLuint program, const GLint location, const GLenum type, const void* pValue)
+	{
+		RenderStats::add(RenderStats::ECounter::UniformUpdates);
+		switch (type)
+		{
+		case GL_FLOAT:
+			glProgramUniform1fv(program, location, 1, static_cast<const GLfloat*>(pValue));
+			break;
+		case GL_FLOAT_VEC2:
+			glProgramUniform2fv(program, location, 1, static_cast<const GLfloat*>(pValue));
+			break;
+		case GL_FLOAT_VEC4:
+			glProgramUniform4fv(program, location, 1, static_cast<const GLfloat*>(pValue));
+			break;
+		case GL_FLOAT_MAT4:
+			glProgramUniformMatrix4fv(program, location, 1, GL_FALSE, static_cast<const GLfloat*>(pValue));
+			break;
+		default:
+			// ints, bools and samplers
+			glProgramUniform1iv(program, location, 1, static_cast<const GLint*>(pValue));
+			break;
+		}
+	}
+
+	bool OpenGLBackend::setUniformBlockBinding(const GLuint program, const std::string& blockName, const GLuint bindingPoint)
+	{
+		const GLuint blockIndex = glGetUniformBlockIndex(program, blockName.c_str());
+		if (blockIndex == GL_INVALID_INDEX) {
+			return false;
+		}
+		glUniformBlockBinding(program, blockIndex, bindingPoint);
+		return true;
+	}
+
+	void OpenGLBackend::drawSpriteQuad()
+	{
+		SpriteQuad::bind();
+		glDrawArrays(GL_TRIANGLES, 0, SpriteQuad::VERTICES_COUNT);
+		RenderStats::addDraw(SpriteQuad::VERTICES_COUNT);
+	}
+
+	void OpenGLBackend::drawQueue(const RenderQueue& renderQueue, const glm::vec2& viewOrigin)
+	{
+		if (!m_pSpriteBatch)
+		{
+			m_pStreamBuffer = std::make_unique<StreamBuffer>(GL_ARRAY_BUFFER, QUEUE_STREAM_BUFFER_REGION_SIZE);
+			m_pSpriteBatch = std::make_unique<SpriteBatch>(*m_pStreamBuffer);
+		}
+
+		m_pSpriteBatch->begin(viewOrigin);
+		renderQueue.emit(*m_pSpriteBatch);
+		m_pSpriteBatch->end();
+		m_pStreamBuffer->endFrame();
+	}
+
+	void OpenGLBackend::releaseResources()
+	{
+		m_pSpriteBatch.reset();
+		m_pStreamBuffer.reset();
+		SpriteQuad::release();
+	}
+
+}
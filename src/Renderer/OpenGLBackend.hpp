@@ -0,0 +1,45 @@
+#pragma once
+
+#include "RenderBackend.hpp"
+
+namespace Renderer {
+
+	class StreamBuffer;
+	class SpriteBatch;
+
+	class OpenGLBackend : public RenderBackend {
+	public:
+		OpenGLBackend();
+		~OpenGLBackend() override;
+
+		EType type() const override { return EType::OpenGL; }
+
+		GLuint createTexture(const GLuint width,
+							 const GLuint height,
+							 const GLenum format,
+							 const std::vector<const unsigned char*>& layersData,
+							 const GLuint filter,
+							 const GLenum wrapMode) override;
+		void deleteTexture(const GLuint texture) override;
+		void bindTexture(const GLuint unit, const GLuint texture) override;
+
+		GLuint createProgram(const std::string& vertexShader, const std::string& fragmentShader) override;
+		void deleteProgram(const GLuint program) override;
+		void useProgram(const GLuint program) override;
+		std::vector<UniformDescription> activeUniforms(const GLuint program) override;
+		void uploadUniform(const GLuint program, const GLint location, const GLenum type, const void* pValue) override;
+		bool setUniformBlockBinding(const GLuint program, const std::string& blockName, const GLuint bindingPoint) override;
+
+		void drawSpriteQuad() override;
+		void drawQueue(const RenderQueue& renderQueue, const glm::vec2& viewOrigin) override;
+		void releaseResources() override;
+
+	private:
+		static bool createShader(const std::string& source, const GLenum shaderType, GLuint& shaderID);
+
+		// created on the first drawQueue
+		std::unique_ptr<StreamBuffer> m_pStreamBuffer;
+		std::unique_ptr<SpriteBatch> m_pSpriteBatch;
+	};
+
+}
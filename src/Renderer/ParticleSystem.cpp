@@ -0,0 +1,178 @@
+#include "ParticleSystem.hpp"
+
+#include "ShaderProgram.hpp"
+#include "RenderQueue.hpp"
+#include "SpriteBatch.hpp"
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BATTLECITY_SSE2
+#endif
+
+namespace Renderer {
+
+	namespace {
+		const unsigned int CELL_SIZE = 4;
+		const unsigned int TEXTURE_WIDTH = ParticleSystem::FRAMES_COUNT * CELL_SIZE;
+		const unsigned int TEXTURE_HEIGHT = static_cast<unsigned int>(ParticleSystem::EPalette::Count) * CELL_SIZE;
+
+		// RGBA as bytes in memory, youngest frame first
+		const std::array<std::array<uint32_t, ParticleSystem::FRAMES_COUNT>, static_cast<size_t>(ParticleSystem::EPalette::Count)> PALETTES = { {
+			{ 0xFFFFFFFFu, 0xFF00E6FFu, 0xFF0080FFu, 0xFF0000C8u },
+			{ 0xFFFFFFFFu, 0xFFBEBEBEu, 0xFF808080u, 0xFF484848u },
+			{ 0xFFFFFFFFu, 0xFFFFDCA0u, 0xFFFF8040u, 0xFFA03020u }
+		} };
+	}
+
+	const ParticleSystem::Emitter ParticleSystem::EXPLOSION = { 48, 16.f, 64.f, 0.3f, 0.7f, 2.f, 3.f, EPalette::Fire };
+	const ParticleSystem::Emitter ParticleSystem::BULLET_HIT = { 8, 24.f, 48.f, 0.1f, 0.25f, 1.f, 6.f, EPalette::Smoke };
+	const ParticleSystem::Emitter ParticleSystem::SPAWN_SPARKLE = { 24, 8.f, 24.f, 0.4f, 0.8f, 1.f, 1.f, EPalette::Sparkle };
+
+	ParticleSystem::ParticleSystem(std::shared_ptr<ShaderProgram> pShaderProgram, const size_t maxParticles, const unsigned int seed) :
+		m_pShaderProgram(std::move(pShaderProgram)),
+		m_random(seed),
+		m_positionsX(maxParticles),
+		m_positionsY(maxParticles),
+		m_velocitiesX(maxParticles),
+		m_velocitiesY(maxParticles),
+		m_drags(maxParticles),
+		m_lives(maxParticles),
+		m_inverseLifetimes(maxParticles),
+		m_sizes(maxParticles),
+		m_palettes(maxParticles)
+	{
+		// one solid cell per palette frame, bottom row first like loaded images
+		std::vector<uint32_t> pixels(static_cast<size_t>(TEXTURE_WIDTH) * TEXTURE_HEIGHT);
+		for (size_t palette = 0; palette < PALETTES.size(); ++palette)
+		{
+			for (unsigned int frame = 0; frame < FRAMES_COUNT; ++frame)
+			{
+				for (unsigned int row = 0; row < CELL_SIZE; ++row)
+				{
+					std::fill_n(pixels.begin() + (palette * CELL_SIZE + row) * TEXTURE_WIDTH + frame * CELL_SIZE, CELL_SIZE, PALETTES[palette][frame]);
+				}
+
+				// the middle of the cell, so nearest sampling never reaches a neighbour
+				const glm::vec2 leftBottom(static_cast<float>(frame * CELL_SIZE + 1), static_cast<float>(palette * CELL_SIZE + 1));
+				const glm::vec2 textureSize(TEXTURE_WIDTH, TEXTURE_HEIGHT);
+				m_frames[palette][frame] = Texture2D::SubTexture2D(leftBottom / textureSize, (leftBottom + glm::vec2(CELL_SIZE - 2)) / textureSize);
+			}
+		}
+		m_pTexture = std::make_shared<Texture2D>(TEXTURE_WIDTH, TEXTURE_HEIGHT, reinterpret_cast<const unsigned char*>(pixels.data()), 4, GL_NEAREST);
+	}
+
+	void ParticleSystem::emit(const Emitter& emitter, const glm::vec2& position)
+	{
+		std::uniform_real_distribution<float> angleDistribution(0.f, 6.2831853f);
+		std::uniform_real_distribution<float> speedDistribution(emitter.minSpeed, emitter.maxSpeed);
+		std::uniform_real_distribution<float> lifetimeDistribution(emitter.minLifetime, emitter.maxLifetime);
+
+		const size_t emittedCount = std::min<size_t>(emitter.particlesCount, capacity() - m_particlesCount);
+		for (size_t i = m_particlesCount; i < m_particlesCount + emittedCount; ++i)
+		{
+			const float angle = angleDistribution(m_random);
+			const float speed = speedDistribution(m_random);
+			const float lifetime = lifetimeDistribution(m_random);
+			m_positionsX[i] = position.x;
+			m_positionsY[i] = position.y;
+			m_velocitiesX[i] = speed * std::cos(angle);
+			m_velocitiesY[i] = speed * std::sin(angle);
+			m_drags[i] = emitter.drag;
+			m_lives[i] = lifetime;
+			m_inverseLifetimes[i] = 1.f / lifetime;
+			m_sizes[i] = emitter.size;
+			m_palettes[i] = emitter.ePalette;
+		}
+		m_particlesCount += emittedCount;
+	}
+
+	void ParticleSystem::update(const uint64_t delta)
+	{
+		const float deltaTime = static_cast<float>(delta * 1e-9);
+
+		size_t i = 0;
+#ifdef BATTLECITY_SSE2
+		const __m128 deltaTimes = _mm_set1_ps(deltaTime);
+		const __m128 zeros = _mm_setzero_ps();
+		const __m128 ones = _mm_set1_ps(1.f);
+		for (; i + 4 <= m_particlesCount; i += 4)
+		{
+			const __m128 dampings = _mm_max_ps(zeros, _mm_sub_ps(ones, _mm_mul_ps(_mm_loadu_ps(&m_drags[i]), deltaTimes)));
+			const __m128 velocitiesX = _mm_mul_ps(_mm_loadu_ps(&m_velocitiesX[i]), dampings);
+			const __m128 velocitiesY = _mm_mul_ps(_mm_loadu_ps(&m_velocitiesY[i]), dampings);
+			_mm_storeu_ps(&m_velocitiesX[i], velocitiesX);
+			_mm_storeu_ps(&m_velocitiesY[i], velocitiesY);
+			_mm_storeu_ps(&m_positionsX[i], _mm_add_ps(_mm_loadu_ps(&m_positionsX[i]), _mm_mul_ps(velocitiesX, deltaTimes)));
+			_mm_storeu_ps(&m_positionsY[i], _mm_add_ps(_mm_loadu_ps(&m_positionsY[i]), _mm_mul_ps(velocitiesY, deltaTimes)));
+			_mm_storeu_ps(&m_lives[i], _mm_sub_ps(_mm_loadu_ps(&m_lives[i]), deltaTimes));
+		}
+#endif
+		for (; i < m_particlesCount; ++i)
+		{
+			const float damping = std::max(0.f, 1.f - m_drags[i] * deltaTime);
+			m_velocitiesX[i] *= damping;
+			m_velocitiesY[i] *= damping;
+			m_positionsX[i] += m_velocitiesX[i] * deltaTime;
+			m_positionsY[i] += m_velocitiesY[i] * deltaTime;
+			m_lives[i] -= deltaTime;
+		}
+
+		removeDead();
+	}
+
+	void ParticleSystem::removeDead()
+	{
+		// backwards, so the particle moved into a hole is always one already checked
+		for (size_t i = m_particlesCount; i-- > 0;)
+		{
+			if (m_lives[i] > 0.f)
+			{
+				continue;
+			}
+
+			const size_t last = --m_particlesCount;
+			m_positionsX[i] = m_positionsX[last];
+			m_positionsY[i] = m_positionsY[last];
+			m_velocitiesX[i] = m_velocitiesX[last];
+			m_velocitiesY[i] = m_velocitiesY[last];
+			m_drags[i] = m_drags[last];
+			m_lives[i] = m_lives[last];
+			m_inverseLifetimes[i] = m_inverseLifetimes[last];
+			m_sizes[i] = m_sizes[last];
+			m_palettes[i] = m_palettes[last];
+		}
+	}
+
+	SpriteInstance ParticleSystem::makeInstance(const size_t index) const
+	{
+		const float age = 1.f - m_lives[index] * m_inverseLifetimes[index];
+		const unsigned int frame = std::min(static_cast<unsigned int>(std::max(age, 0.f) * FRAMES_COUNT), FRAMES_COUNT - 1);
+		const float size = m_sizes[index];
+		const glm::vec2 position = glm::floor(glm::vec2(m_positionsX[index], m_positionsY[index]) - 0.5f * size + 0.5f);
+		return SpriteInstance{ position, glm::vec2(size), 0.f, m_frames[static_cast<size_t>(m_palettes[index])][frame] };
+	}
+
+	void ParticleSystem::submit(RenderQueue& renderQueue, const ERenderLayer layer) const
+	{
+		// every particle shares the key, the stable sort keeps them in order
+		const uint64_t sortKey = RenderQueue::makeSortKey(layer, m_pShaderProgram->id(), m_pTexture->id(), 0.f);
+		for (size_t i = 0; i < m_particlesCount; ++i)
+		{
+			renderQueue.submit(sortKey, RenderQueue::Command{ m_pShaderProgram.get(), m_pTexture.get(), makeInstance(i) });
+		}
+	}
+
+	void ParticleSystem::submit(SpriteBatch& spriteBatch) const
+	{
+		for (size_t i = 0; i < m_particlesCount; ++i)
+		{
+			spriteBatch.submit(m_pShaderProgram.get(), m_pTexture.get(), makeInstance(i));
+		}
+	}
+
+}
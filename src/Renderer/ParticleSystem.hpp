@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Sprite.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace Renderer {
+
+	class ShaderProgram;
+	class RenderQueue;
+	class SpriteBatch;
+	enum class ERenderLayer : uint8_t;
+
+	// Short-lived square particles for explosions, bullet hits and spawn
+	// sparkles. Particles are stored as structure of arrays sized up front,
+	// so an update is a few SSE passes over contiguous floats and dead
+	// particles are dropped by moving the last one into their place. All of
+	// them share one small generated texture and go out in one batch; the
+	// colour steps through the palette's frames as the particle ages.
+	class ParticleSystem {
+	public:
+		enum class EPalette : uint8_t {
+			// white, yellow, orange, red
+			Fire,
+			// white, light grey, grey, dark grey
+			Smoke,
+			// white, light blue, blue, dark blue
+			Sparkle,
+			Count
+		};
+
+		struct Emitter {
+			unsigned int particlesCount;
+			// pixels per second, in a random direction
+			float minSpeed;
+			float maxSpeed;
+			// seconds
+			float minLifetime;
+			float maxLifetime;
+			float size;
+			// fraction of the velocity lost per second
+			float drag;
+			EPalette ePalette;
+		};
+
+		static const Emitter EXPLOSION;
+		static const Emitter BULLET_HIT;
+		static const Emitter SPAWN_SPARKLE;
+
+		static constexpr unsigned int FRAMES_COUNT = 4;
+		static constexpr size_t DEFAULT_MAX_PARTICLES = 1 << 17;
+
+		ParticleSystem(std::shared_ptr<ShaderProgram> pShaderProgram, const size_t maxParticles = DEFAULT_MAX_PARTICLES, const unsigned int seed = 1);
+
+		ParticleSystem(const ParticleSystem&) = delete;
+		ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+		// particles over maxParticles are dropped
+		void emit(const Emitter& emitter, const glm::vec2& position);
+		void update(const uint64_t delta);
+		void clear() { m_particlesCount = 0; }
+
+		void submit(RenderQueue& renderQueue, const ERenderLayer layer) const;
+		void submit(SpriteBatch& spriteBatch) const;
+
+		size_t size() const { return m_particlesCount; }
+		size_t capacity() const { return m_positionsX.size(); }
+
+	private:
+		// position is the centre, snapped to whole pixels like the rest of the game
+		SpriteInstance makeInstance(const size_t index) const;
+		void removeDead();
+
+		std::shared_ptr<ShaderProgram> m_pShaderProgram;
+		std::shared_ptr<Texture2D> m_pTexture;
+		std::array<std::array<Texture2D::SubTexture2D, FRAMES_COUNT>, static_cast<size_t>(EPalette::Count)> m_frames;
+		std::minstd_rand m_random;
+
+		size_t m_particlesCount = 0;
+		std::vector<float> m_positionsX;
+		std::vector<float> m_positionsY;
+		std::vector<float> m_velocitiesX;
+		std::vector<float> m_velocitiesY;
+		std::vector<float> m_drags;
+		// seconds left, dead at zero
+		std::vector<float> m_lives;
+		std::vector<float> m_inverseLifetimes;
+		std::vector<float> m_sizes;
+		std::vector<EPalette> m_palettes;
+	};
+
+}
@@ -0,0 +1,186 @@
+#include "ProgramBinaryCache.hpp"
+
+#include "GLStateCache.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace Renderer {
+
+	namespace {
+		// char magic[8] | uint32 version | uint64 key | uint32 binaryFormat | uint32 binarySize | double compileTime | binary
+		const char MAGIC[8] = { 'B', 'C', 'P', 'R', 'O', 'G', '\0', '\0' };
+		const uint32_t VERSION = 1;
+
+		struct EntryHeader {
+			char magic[8];
+			uint32_t version;
+			uint64_t key;
+			uint32_t binaryFormat;
+			uint32_t binarySize;
+			double compileTime;
+		};
+
+		// FNV-1a
+		void hash(uint64_t& value, const std::string& text)
+		{
+			for (const char character : text)
+			{
+				value = (value ^ static_cast<unsigned char>(character)) * 1099511628211ull;
+			}
+			// keeps "ab" + "c" apart from "a" + "bc"
+			value = (value ^ 0xFFu) * 1099511628211ull;
+		}
+
+		std::string glString(const GLenum name)
+		{
+			const GLubyte* pString = glGetString(name);
+			return pString ? reinterpret_cast<const char*>(pString) : "";
+		}
+	}
+
+	bool ProgramBinaryCache::m_isOpen = false;
+	std::string ProgramBinaryCache::m_directory;
+	std::string ProgramBinaryCache::m_driver;
+	ProgramBinaryCache::Stats ProgramBinaryCache::m_stats;
+
+	bool ProgramBinaryCache::open(const std::string& directory)
+	{
+		GLint formatsCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatsCount);
+		if (formatsCount == 0)
+		{
+			std::cerr << "The driver has no program binary formats, shaders will be compiled every run" << std::endl;
+			return false;
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+		if (error)
+		{
+			std::cerr << "Can't create the shader cache directory: " << directory << std::endl;
+			return false;
+		}
+
+		m_directory = directory;
+		m_driver = glString(GL_VENDOR) + '\n' + glString(GL_RENDERER) + '\n' + glString(GL_VERSION);
+		m_isOpen = true;
+		return true;
+	}
+
+	uint64_t ProgramBinaryCache::makeKey(const std::string& vertexShader, const std::string& fragmentShader)
+	{
+		uint64_t key = 14695981039346656037ull;
+		hash(key, vertexShader);
+		hash(key, fragmentShader);
+		hash(key, m_driver);
+		return key;
+	}
+
+	std::string ProgramBinaryCache::entryPath(const uint64_t key)
+	{
+		char name[17];
+		std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+		return m_directory + "/" + name + ".bin";
+	}
+
+	GLuint ProgramBinaryCache::load(const std::string& vertexShader, const std::string& fragmentShader)
+	{
+		auto startTime = std::chrono::high_resolution_clock::now();
+		const uint64_t key = makeKey(vertexShader, fragmentShader);
+
+		std::ifstream file(entryPath(key), std::ios::binary | std::ios::ate);
+		const std::streamoff fileSize = file.is_open() ? static_cast<std::streamoff>(file.tellg()) : 0;
+		file.seekg(0);
+		EntryHeader header{};
+		if (!file.is_open() || !file.read(reinterpret_cast<char*>(&header), sizeof(header))
+			|| std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.key != key
+			|| static_cast<std::streamoff>(sizeof(header) + header.binarySize) != fileSize)
+		{
+			++m_stats.missesCount;
+			return 0;
+		}
+		std::vector<char> binary(header.binarySize);
+		if (!file.read(binary.data(), static_cast<std::streamsize>(binary.size())))
+		{
+			++m_stats.missesCount;
+			return 0;
+		}
+
+		// drivers may refuse binaries after an update that keeps the version string
+		GLuint program = glCreateProgram();
+		glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+		GLint success = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (!success)
+		{
+			GLStateCache::deleteProgram(program);
+			++m_stats.missesCount;
+			++m_stats.rejectedCount;
+			return 0;
+		}
+
+		const double loadTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+		++m_stats.hitsCount;
+		m_stats.loadTime += loadTime;
+		m_stats.savedTime += header.compileTime - loadTime;
+		return program;
+	}
+
+	void ProgramBinaryCache::store(const GLuint program, const std::string& vertexShader, const std::string& fragmentShader, const double compileTime)
+	{
+		m_stats.compileTime += compileTime;
+
+		GLint binarySize = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+		if (binarySize <= 0)
+		{
+			return;
+		}
+		std::vector<char> binary(static_cast<size_t>(binarySize));
+		GLenum binaryFormat = 0;
+		glGetProgramBinary(program, binarySize, nullptr, &binaryFormat, binary.data());
+
+		const uint64_t key = makeKey(vertexShader, fragmentShader);
+		EntryHeader header{};
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.key = key;
+		header.binaryFormat = binaryFormat;
+		header.binarySize = static_cast<uint32_t>(binary.size());
+		header.compileTime = compileTime;
+
+		// written aside and renamed into place, so another instance starting
+		// at the same time sees either no entry or a whole one
+		const std::string path = entryPath(key);
+		const std::string temporaryPath = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()))
+										  + "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+			if (!file.is_open() || !file.write(reinterpret_cast<const char*>(&header), sizeof(header)) || !file.write(binary.data(), static_cast<std::streamsize>(binary.size())))
+			{
+				std::cerr << "Can't write the shader cache entry: " << path << std::endl;
+				file.close();
+				std::error_code error;
+				std::filesystem::remove(temporaryPath, error);
+				return;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporaryPath, path, error);
+		if (error)
+		{
+			std::cerr << "Can't write the shader cache entry: " << path << std::endl;
+			std::filesystem::remove(temporaryPath, error);
+		}
+	}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <string>
+
+namespace Renderer {
+
+	// Linked programs saved with glGetProgramBinary and loaded back with
+	// glProgramBinary on later runs, so startup skips compiling and linking.
+	// An entry is keyed by a hash of both sources and the driver's vendor,
+	// renderer and version strings; a binary the driver rejects counts as a
+	// miss and is replaced once the program is compiled again.
+	class ProgramBinaryCache {
+	public:
+		struct Stats {
+			size_t hitsCount = 0;
+			size_t missesCount = 0;
+			// misses with a binary on disk the driver didn't accept
+			size_t rejectedCount = 0;
+			// milliseconds spent loading hits and compiling misses
+			double loadTime = 0.0;
+			double compileTime = 0.0;
+			// compile time recorded with each hit minus its load time
+			double savedTime = 0.0;
+		};
+
+		// call with a current context; false if the driver can't return binaries
+		static bool open(const std::string& directory);
+		static void close() { m_isOpen = false; }
+		static bool isOpen() { return m_isOpen; }
+
+		// the linked program, 0 on a miss
+		static GLuint load(const std::string& vertexShader, const std::string& fragmentShader);
+		// program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT; compileTime in milliseconds
+		static void store(const GLuint program, const std::string& vertexShader, const std::string& fragmentShader, const double compileTime);
+
+		static const Stats& stats() { return m_stats; }
+
+		ProgramBinaryCache() = delete;
+		~ProgramBinaryCache() = delete;
+
+	private:
+		static uint64_t makeKey(const std::string& vertexShader, const std::string& fragmentShader);
+		static std::string entryPath(const uint64_t key);
+
+		static bool m_isOpen;
+		static std::string m_directory;
+		// vendor, renderer and version, part of every key
+		static std::string m_driver;
+		static Stats m_stats;
+	};
+
+}
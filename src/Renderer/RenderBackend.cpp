@@ -0,0 +1,32 @@
+#include "RenderBackend.hpp"
+
+#include "OpenGLBackend.hpp"
+
+#include <iostream>
+
+namespace Renderer {
+
+	std::unique_ptr<RenderBackend> RenderBackend::m_pCurrent;
+	std::atomic<size_t> RenderBackend::m_objectsCount(0);
+
+	RenderBackend& RenderBackend::current()
+	{
+		if (!m_pCurrent)
+		{
+			m_pCurrent = std::make_unique<OpenGLBackend>();
+		}
+		return *m_pCurrent;
+	}
+
+	bool RenderBackend::setCurrent(std::unique_ptr<RenderBackend> pBackend)
+	{
+		if (m_objectsCount != 0)
+		{
+			std::cerr << "Can't switch the render backend: " << m_objectsCount << " textures and shader programs still use the current one" << std::endl;
+			return false;
+		}
+		m_pCurrent = std::move(pBackend);
+		return true;
+	}
+
+}
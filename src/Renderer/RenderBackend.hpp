@@ -0,0 +1,86 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/vec2.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Renderer {
+
+	class RenderQueue;
+	class Texture2D;
+	class ShaderProgram;
+
+	// Everything Texture2D, ShaderProgram and Sprite ask of the graphics API.
+	// Object names are GLuint for every backend so sort keys and ids keep
+	// working; backends without GL hand out their own. The GPU-only parts of
+	// the frame (SpriteBatch, TileMapRenderer, FrameBuffer) call GL directly
+	// and run with every backend but Software; the null backend answers them
+	// with no-op entry points.
+	class RenderBackend {
+	public:
+		enum class EType {
+			OpenGL,
+			Software,
+			Null
+		};
+
+		struct UniformDescription {
+			std::string name;
+			GLint location;
+			GLenum type;
+		};
+
+		virtual ~RenderBackend() = default;
+
+		virtual EType type() const = 0;
+
+		// format is GL_RGBA or GL_RGB, one data pointer per layer
+		virtual GLuint createTexture(const GLuint width,
+									 const GLuint height,
+									 const GLenum format,
+									 const std::vector<const unsigned char*>& layersData,
+									 const GLuint filter,
+									 const GLenum wrapMode) = 0;
+		virtual void deleteTexture(const GLuint texture) = 0;
+		virtual void bindTexture(const GLuint unit, const GLuint texture) = 0;
+		// true if textures must keep a CPU copy of their pixels, see Texture2D::pixels
+		virtual bool needsCpuPixels() const { return false; }
+
+		// compiles and links, returns 0 on failure
+		virtual GLuint createProgram(const std::string& vertexShader, const std::string& fragmentShader) = 0;
+		virtual void deleteProgram(const GLuint program) = 0;
+		virtual void useProgram(const GLuint program) = 0;
+		// uniforms outside of blocks; arrays by their plain name
+		virtual std::vector<UniformDescription> activeUniforms(const GLuint program) = 0;
+		virtual void uploadUniform(const GLuint program, const GLint location, const GLenum type, const void* pValue) = 0;
+		virtual bool setUniformBlockBinding(const GLuint program, const std::string& blockName, const GLuint bindingPoint) = 0;
+
+		// the shared unit quad with the current program and texture, see Sprite::render
+		virtual void drawSpriteQuad() = 0;
+		// a sorted queue, for frames drawn without the GPU-only path; viewOrigin is
+		// the world position shown at the bottom left (see Camera), so the OpenGL
+		// backend expects a FrameData projection without the view
+		virtual void drawQueue(const RenderQueue& renderQueue, const glm::vec2& viewOrigin) = 0;
+		// drops objects the backend made for itself, while its context is still alive
+		virtual void releaseResources() = 0;
+
+		// OpenGL until replaced
+		static RenderBackend& current();
+		// objects keep names of the backend that created them, so this fails while
+		// any texture or shader program is alive; nullptr destroys the current one
+		static bool setCurrent(std::unique_ptr<RenderBackend> pBackend);
+
+	private:
+		friend class Texture2D;
+		friend class ShaderProgram;
+
+		static std::unique_ptr<RenderBackend> m_pCurrent;
+		// textures and shader programs holding a name of the current backend
+		static std::atomic<size_t> m_objectsCount;
+	};
+
+}
@@ -0,0 +1,165 @@
+#include "RenderQueue.hpp"
+
+#include "ShaderProgram.hpp"
+#include "Texture2D.hpp"
+#include "SpriteBatch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace Renderer {
+
+	namespace {
+		// maps a float to an unsigned integer with the same ordering
+		uint32_t orderedDepth(const float depth)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &depth, sizeof(bits));
+			return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+		}
+	}
+
+	RenderQueue::RenderQueue(const size_t reserveCommands)
+	{
+		m_commands.reserve(reserveCommands);
+		m_items.reserve(reserveCommands);
+	}
+
+	uint64_t RenderQueue::makeSortKey(const ERenderLayer layer, const GLuint shaderID, const GLuint textureID, const float depth)
+	{
+		return (static_cast<uint64_t>(layer) << 56)
+			 | (static_cast<uint64_t>(shaderID & 0xFFFu) << 44)
+			 | (static_cast<uint64_t>(textureID & 0xFFFu) << 32)
+			 | static_cast<uint64_t>(orderedDepth(depth));
+	}
+
+	void RenderQueue::submit(const ERenderLayer layer,
+							 const float depth,
+							 ShaderProgram& shaderProgram,
+							 Texture2D& texture,
+							 const SpriteInstance& instance)
+	{
+		submit(makeSortKey(layer, shaderProgram.id(), texture.id(), depth), Command{ &shaderProgram, &texture, instance });
+	}
+
+	void RenderQueue::submit(const uint64_t sortKey, const Command& command)
+	{
+		m_items.push_back(SortItem{ sortKey, static_cast<uint32_t>(m_commands.size()) });
+		m_commands.push_back(command);
+		m_isSorted = false;
+	}
+
+	size_t RenderQueue::grow(const size_t commandsCount)
+	{
+		const size_t firstIndex = m_commands.size();
+		m_commands.resize(firstIndex + commandsCount);
+		m_items.resize(firstIndex + commandsCount);
+		m_isSorted = m_isSorted && commandsCount == 0;
+		return firstIndex;
+	}
+
+	void RenderQueue::copyTo(RenderQueue& target, const size_t targetIndex) const
+	{
+		std::copy(m_commands.begin(), m_commands.end(), target.m_commands.begin() + targetIndex);
+		const uint32_t indexOffset = static_cast<uint32_t>(targetIndex);
+		auto targetItem = target.m_items.begin() + targetIndex;
+		for (const SortItem& item : m_items)
+		{
+			*targetItem++ = SortItem{ item.key, item.commandIndex + indexOffset };
+		}
+	}
+
+	void RenderQueue::append(const RenderQueue& other)
+	{
+		other.copyTo(*this, grow(other.size()));
+	}
+
+	void RenderQueue::sort()
+	{
+		if (m_isSorted || m_items.empty())
+		{
+			return;
+		}
+
+		// LSD radix sort, one byte per pass. Passes where every key shares
+		// the same byte (usually layer, shader and texture) are skipped.
+		const size_t itemsCount = m_items.size();
+		m_sortBuffer.resize(itemsCount);
+
+		std::array<std::array<uint32_t, 256>, sizeof(uint64_t)> histograms{};
+		for (const SortItem& item : m_items)
+		{
+			for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+			{
+				++histograms[byte][(item.key >> (8 * byte)) & 0xFF];
+			}
+		}
+
+		for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+		{
+			auto& histogram = histograms[byte];
+			if (histogram[(m_items.front().key >> (8 * byte)) & 0xFF] == itemsCount)
+			{
+				continue;
+			}
+
+			uint32_t offset = 0;
+			for (auto& bucket : histogram)
+			{
+				const uint32_t count = bucket;
+				bucket = offset;
+				offset += count;
+			}
+
+			for (const SortItem& item : m_items)
+			{
+				m_sortBuffer[histogram[(item.key >> (8 * byte)) & 0xFF]++] = item;
+			}
+			m_items.swap(m_sortBuffer);
+		}
+
+		m_isSorted = true;
+	}
+
+	void RenderQueue::emit(SpriteBatch& spriteBatch) const
+	{
+		for (const SortItem& item : m_items)
+		{
+			const Command& command = m_commands[item.commandIndex];
+			spriteBatch.submit(command.pShaderProgram, command.pTexture, command.instance);
+		}
+	}
+
+	void RenderQueue::emit(SpriteBatch& spriteBatch, const ERenderLayer firstLayer, const ERenderLayer lastLayer) const
+	{
+		const uint64_t firstKey = static_cast<uint64_t>(firstLayer) << 56;
+		auto first = std::lower_bound(m_items.begin(), m_items.end(), firstKey, [](const SortItem& item, const uint64_t key) {
+			return item.key < key;
+		});
+
+		const uint64_t lastLayerIndex = static_cast<uint64_t>(lastLayer);
+		for (auto it = first; it != m_items.end() && (it->key >> 56) <= lastLayerIndex; ++it)
+		{
+			const Command& command = m_commands[it->commandIndex];
+			spriteBatch.submit(command.pShaderProgram, command.pTexture, command.instance);
+		}
+	}
+
+	void RenderQueue::flush(SpriteBatch& spriteBatch)
+	{
+		sort();
+		spriteBatch.begin();
+		emit(spriteBatch);
+		spriteBatch.end();
+		clear();
+	}
+
+	void RenderQueue::clear()
+	{
+		m_commands.clear();
+		m_items.clear();
+		m_isSorted = true;
+	}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Sprite.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Renderer {
+
+	class ShaderProgram;
+	class Texture2D;
+	class SpriteBatch;
+
+	enum class ERenderLayer : uint8_t {
+		Ground,
+		Tanks,
+		Bullets,
+		Forest,
+		HUD
+	};
+
+	// Collects sprite submissions for one frame and replays them through a
+	// SpriteBatch ordered by a 64-bit key:
+	//   layer (8 bits) | shader (12 bits) | texture (12 bits) | depth (32 bits)
+	// so layering stays correct while sprites sharing state end up adjacent.
+	class RenderQueue {
+	public:
+		struct Command {
+			ShaderProgram* pShaderProgram;
+			Texture2D* pTexture;
+			SpriteInstance instance;
+		};
+
+		RenderQueue(const size_t reserveCommands = 1024);
+
+		RenderQueue(const RenderQueue&) = delete;
+		RenderQueue& operator=(const RenderQueue&) = delete;
+
+		static uint64_t makeSortKey(const ERenderLayer layer, const GLuint shaderID, const GLuint textureID, const float depth);
+
+		void submit(const ERenderLayer layer,
+					const float depth,
+					ShaderProgram& shaderProgram,
+					Texture2D& texture,
+					const SpriteInstance& instance);
+		void submit(const uint64_t sortKey, const Command& command);
+
+		// adds commandsCount unset commands at the end and returns the index of the first
+		size_t grow(const size_t commandsCount);
+		// writes the commands to target from targetIndex on, target
+		// must have room for them; different ranges of one target can be written concurrently
+		void copyTo(RenderQueue& target, const size_t targetIndex) const;
+		void append(const RenderQueue& other);
+
+		void sort();
+		void emit(SpriteBatch& spriteBatch) const;
+		// emits only the commands of [firstLayer, lastLayer], the queue must be sorted
+		void emit(SpriteBatch& spriteBatch, const ERenderLayer firstLayer, const ERenderLayer lastLayer) const;
+		void flush(SpriteBatch& spriteBatch);
+		void clear();
+
+		size_t size() const { return m_commands.size(); }
+		const Command& command(const size_t sortedIndex) const { return m_commands[m_items[sortedIndex].commandIndex]; }
+
+	private:
+		struct SortItem {
+			uint64_t key;
+			uint32_t commandIndex;
+		};
+
+		std::vector<Command> m_commands;
+		std::vector<SortItem> m_items;
+		std::vector<SortItem> m_sortBuffer;
+		bool m_isSorted = true;
+	};
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "RenderQueue.hpp"
+#include "Camera.hpp"
+#include "AnimationClipTable.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Renderer {
+
+	// A tile of the level changed by the update: the brick quarters left on
+	// it, 0 empties it. The render side applies it to the map it draws.
+	struct TileEdit {
+		uint16_t x = 0;
+		uint16_t y = 0;
+		uint8_t bricks = 0;
+		// the first snapshot carrying the edit
+		uint64_t snapshotIndex = 0;
+	};
+
+	// Everything the render of one frame reads from the game, written by the
+	// update and left alone afterwards, so it can be drawn on another thread
+	// while the next frame is simulated. Textures and shaders referenced by
+	// the queue are loaded up front and never change.
+	struct RenderSnapshot {
+		// sorted sprite commands; with the software backend the level tiles too
+		RenderQueue renderQueue;
+		glm::vec2 windowSize = glm::vec2(0.f);
+		// the view the queue was culled against
+		Camera camera;
+		// seconds, drives tile and clip animation
+		float time = 0.f;
+		// counts published snapshots from 1, so a snapshot drawn twice applies its edits once
+		uint64_t index = 0;
+		// in order, every edit the render side may not have applied yet; it skips
+		// those of snapshots it has drawn, so a replaced snapshot loses nothing
+		std::vector<TileEdit> tileEdits;
+		std::shared_ptr<const AnimationClipTable::Data> pAnimationClips;
+	};
+
+}
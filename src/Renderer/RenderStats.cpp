@@ -0,0 +1,93 @@
+#include "RenderStats.hpp"
+
+#include "GLStateCache.hpp"
+
+#include <sstream>
+
+namespace Renderer {
+
+	RenderStats::Counters RenderStats::m_currentFrame{};
+	RenderStats::Counters RenderStats::m_lastFrame{};
+	size_t RenderStats::m_framesCount = 0;
+
+	void RenderStats::addDraw(const size_t verticesCount)
+	{
+		add(ECounter::DrawCalls);
+		add(ECounter::Vertices, verticesCount);
+	}
+
+	void RenderStats::addUpload(const size_t bytesCount)
+	{
+		add(ECounter::BufferUploads);
+		add(ECounter::BufferUploadBytes, bytesCount);
+	}
+
+	void RenderStats::endFrame()
+	{
+		using EStateKind = GLStateCache::EStateKind;
+		const GLStateCache::Counters& stateCounters = GLStateCache::frameCounters();
+		m_currentFrame[static_cast<size_t>(ECounter::ProgramSwitches)] = stateCounters.issued[static_cast<size_t>(EStateKind::Program)];
+		m_currentFrame[static_cast<size_t>(ECounter::TextureBinds)] = stateCounters.issued[static_cast<size_t>(EStateKind::Texture)];
+		m_currentFrame[static_cast<size_t>(ECounter::VertexArrayBinds)] = stateCounters.issued[static_cast<size_t>(EStateKind::VertexArray)];
+
+		m_lastFrame = m_currentFrame;
+		m_currentFrame.fill(0);
+		++m_framesCount;
+	}
+
+	const char* RenderStats::counterName(const ECounter counter)
+	{
+		switch (counter)
+		{
+		case ECounter::DrawCalls:
+			return "draws";
+		case ECounter::Vertices:
+			return "vertices";
+		case ECounter::ProgramSwitches:
+			return "programs";
+		case ECounter::TextureBinds:
+			return "textures";
+		case ECounter::VertexArrayBinds:
+			return "vaos";
+		case ECounter::BufferUploads:
+			return "uploads";
+		case ECounter::BufferUploadBytes:
+			return "upload_bytes";
+		case ECounter::UniformUpdates:
+			return "uniforms";
+		default:
+			return "unknown";
+		}
+	}
+
+	std::string RenderStats::toString(const Counters& counters)
+	{
+		std::ostringstream stream;
+		for (size_t counter = 0; counter < counters.size(); ++counter)
+		{
+			stream << (counter ? " " : "") << counterName(static_cast<ECounter>(counter)) << " " << counters[counter];
+		}
+		return stream.str();
+	}
+
+	void RenderStats::writeCsvHeader(std::ostream& stream)
+	{
+		stream << "frame";
+		for (size_t counter = 0; counter < static_cast<size_t>(ECounter::Count); ++counter)
+		{
+			stream << "," << counterName(static_cast<ECounter>(counter));
+		}
+		stream << "\n";
+	}
+
+	void RenderStats::writeCsvRow(std::ostream& stream, const Counters& counters)
+	{
+		stream << m_framesCount;
+		for (const size_t value : counters)
+		{
+			stream << "," << value;
+		}
+		stream << "\n";
+	}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace Renderer {
+
+	// Per-frame totals of the work the renderer hands to GL. Draws, uploads
+	// and uniform updates are added where they are issued; binds are taken
+	// from the GLStateCache counters, so only binds that reached the driver
+	// are counted. Call endFrame() once the frame is submitted.
+	class RenderStats {
+	public:
+		enum class ECounter {
+			DrawCalls,
+			Vertices,
+			ProgramSwitches,
+			TextureBinds,
+			VertexArrayBinds,
+			BufferUploads,
+			BufferUploadBytes,
+			UniformUpdates,
+			Count
+		};
+
+		using Counters = std::array<size_t, static_cast<size_t>(ECounter::Count)>;
+
+		static void add(const ECounter counter, const size_t value = 1) { m_currentFrame[static_cast<size_t>(counter)] += value; }
+		static void addDraw(const size_t verticesCount);
+		static void addUpload(const size_t bytesCount);
+
+		static void endFrame();
+		// totals of the last finished frame
+		static const Counters& lastFrame() { return m_lastFrame; }
+		static size_t framesCount() { return m_framesCount; }
+
+		static const char* counterName(const ECounter counter);
+		// one line, for the console
+		static std::string toString(const Counters& counters);
+		static void writeCsvHeader(std::ostream& stream);
+		static void writeCsvRow(std::ostream& stream, const Counters& counters);
+
+		RenderStats() = delete;
+		~RenderStats() = delete;
+
+	private:
+		static Counters m_currentFrame;
+		static Counters m_lastFrame;
+		static size_t m_framesCount;
+	};
+
+}
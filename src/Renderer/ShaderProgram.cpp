@@ -1,71 +1,52 @@
 #include "ShaderProgram.hpp"
-#include <glm/gtc/type_ptr.hpp>
-#include <iostream>
 
 namespace Renderer {
 	ShaderProgram::ShaderProgram(const std::string& vertexShader, const std::string& fragmentShader) {
-		GLuint vertexShaderID;
-		if (!createShader(vertexShader, GL_VERTEX_SHADER, vertexShaderID)) {
-			std::cerr << "VERTEX SHADER compile time error" << std::endl;
-			return;
-		}
-
-		GLuint fragmentShaderID;
-		if (!createShader(fragmentShader, GL_FRAGMENT_SHADER, fragmentShaderID)) {
-			std::cerr << "FRAGMENT SHADER compile time error" << std::endl;
-			glDeleteShader(vertexShaderID);
-			return;
-		}
-
-		m_ID = glCreateProgram();
-		glAttachShader(m_ID, vertexShaderID);
-		glAttachShader(m_ID, fragmentShaderID);
-		glLinkProgram(m_ID);
-
-		GLint success;
-		glGetProgramiv(m_ID, GL_LINK_STATUS, &success);
-		if (!success) {
-			GLchar infoLog[1024];
-			glGetShaderInfoLog(m_ID, 1024, nullptr, infoLog);
-			std::cerr << "ERROR::SHADER: Link-time error:\n" << infoLog << std::endl;
-		}
-		else {
+		m_ID = RenderBackend::current().createProgram(vertexShader, fragmentShader);
+		if (m_ID != 0) {
+			++RenderBackend::m_objectsCount;
 			m_isCompiled = true;
+			reflectUniforms();
 		}
-		glDeleteShader(vertexShaderID);
-		glDeleteShader(fragmentShaderID);
 	}
 
-	bool ShaderProgram::createShader(const std::string& source, const GLenum shaderType, GLuint& shaderID) {
-		shaderID = glCreateShader(shaderType);
-		const char* code = source.c_str();
-		glShaderSource(shaderID, 1, &code, nullptr);
-		glCompileShader(shaderID);
-
-		GLint success;
-		glGetShaderiv(shaderID, GL_COMPILE_STATUS, &success);
+	void ShaderProgram::reflectUniforms() {
+		m_uniforms.clear();
+		m_uniformsIndices.clear();
+		for (auto& uniform : RenderBackend::current().activeUniforms(m_ID)) {
+			m_uniformsIndices.emplace(std::move(uniform.name), static_cast<int>(m_uniforms.size()));
+			m_uniforms.push_back(Uniform{ uniform.location, uniform.type, false, {} });
+		}
+	}
 
-		if (!success) {
-			GLchar infoLog[1024];
-			glGetShaderInfoLog(shaderID, 1024, nullptr, infoLog);
-			std::cerr << "ERROR::SHADER: compile time error!\n" << infoLog << std::endl;
-			return false;
+	int ShaderProgram::findUniform(const std::string& name) const {
+		auto it = m_uniformsIndices.find(name);
+		if (it == m_uniformsIndices.end()) {
+			return -1;
 		}
-		return true;
+		return it->second;
 	}
 
 	ShaderProgram::~ShaderProgram() {
-		glDeleteProgram(m_ID);
+		if (m_ID != 0) {
+			RenderBackend::current().deleteProgram(m_ID);
+			--RenderBackend::m_objectsCount;
+		}
 	}
 
 	void ShaderProgram::use() const {
-		glUseProgram(m_ID);
+		RenderBackend::current().useProgram(m_ID);
 	}
 
 	ShaderProgram& ShaderProgram::operator=(ShaderProgram&& shaderProgram) noexcept {
-		glDeleteProgram(m_ID);
+		if (m_ID != 0) {
+			RenderBackend::current().deleteProgram(m_ID);
+			--RenderBackend::m_objectsCount;
+		}
 		m_ID = shaderProgram.m_ID;
 		m_isCompiled = shaderProgram.m_isCompiled;
+		m_uniforms = std::move(shaderProgram.m_uniforms);
+		m_uniformsIndices = std::move(shaderProgram.m_uniformsIndices);
 
 		shaderProgram.m_ID = NULL;
 		shaderProgram.m_isCompiled = false;
@@ -75,17 +56,26 @@ namespace Renderer {
 	ShaderProgram::ShaderProgram(ShaderProgram&& shaderProgram) noexcept {
 		m_ID = shaderProgram.m_ID;
 		m_isCompiled = shaderProgram.m_isCompiled;
+		m_uniforms = std::move(shaderProgram.m_uniforms);
+		m_uniformsIndices = std::move(shaderProgram.m_uniformsIndices);
 
 		shaderProgram.m_ID = NULL;
 		shaderProgram.m_isCompiled = false;
 	}
 
 	void ShaderProgram::setInt(const std::string& name, const GLint value) {
-		glUniform1i(glGetUniformLocation(m_ID, name.c_str()), value);
+		setUniform(getUniform<GLint>(name), value);
 	}
 
+	void ShaderProgram::setVec4(const std::string& name, const glm::vec4& vector) {
+		setUniform(getUniform<glm::vec4>(name), vector);
+	}
 
 	void ShaderProgram::setMatrix4(const std::string& name, const glm::mat4& matrix) {
-		glUniformMatrix4fv(glGetUniformLocation(m_ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(matrix));
+		setUniform(getUniform<glm::mat4>(name), matrix);
+	}
+
+	bool ShaderProgram::setUniformBlockBinding(const std::string& blockName, const GLuint bindingPoint) {
+		return RenderBackend::current().setUniformBlockBinding(m_ID, blockName, bindingPoint);
 	}
 }
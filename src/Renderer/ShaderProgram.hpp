@@ -1,18 +1,91 @@
 #pragma once
 
 #include <glad/glad.h>
+#include <cassert>
+#include <cstring>
 #include <string>
+#include <vector>
+#include <unordered_map>
 #include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "RenderBackend.hpp"
 
 namespace Renderer {
+
+	template<class T>
+	struct UniformTraits;
+
+	template<>
+	struct UniformTraits<GLint> {
+		static bool accepts(const GLenum type) {
+			switch (type) {
+			case GL_INT:
+			case GL_BOOL:
+			case GL_SAMPLER_2D:
+			case GL_SAMPLER_2D_ARRAY:
+			case GL_INT_SAMPLER_2D:
+			case GL_UNSIGNED_INT_SAMPLER_2D:
+				return true;
+			default:
+				return false;
+			}
+		}
+	};
+
+	template<>
+	struct UniformTraits<GLfloat> {
+		static bool accepts(const GLenum type) { return type == GL_FLOAT; }
+	};
+
+	template<>
+	struct UniformTraits<glm::vec2> {
+		static bool accepts(const GLenum type) { return type == GL_FLOAT_VEC2; }
+	};
+
+	template<>
+	struct UniformTraits<glm::vec4> {
+		static bool accepts(const GLenum type) { return type == GL_FLOAT_VEC4; }
+	};
+
+	template<>
+	struct UniformTraits<glm::mat4> {
+		static bool accepts(const GLenum type) { return type == GL_FLOAT_MAT4; }
+	};
+
+	// Index into the uniform table of the program it was obtained from,
+	// which setUniform asserts on. A default constructed handle is invalid
+	// and setting it is a no-op.
+	template<class T>
+	class UniformHandle {
+	public:
+		UniformHandle() = default;
+		bool isValid() const { return m_index >= 0; }
+
+	private:
+		friend class ShaderProgram;
+		UniformHandle(const GLuint program, const int index) : m_program(program), m_index(index) {}
+
+		GLuint m_program = 0;
+		int m_index = -1;
+	};
+
 	class ShaderProgram {
 	public:
 		ShaderProgram(const std::string& vertexShader, const std::string& fragmentShader);
 		~ShaderProgram();
 		bool isCompiled() const { return m_isCompiled; }
+		GLuint id() const { return m_ID; }
 		void use() const;
 		void setInt(const std::string& name, const GLint value);
+		void setVec4(const std::string& name, const glm::vec4& vector);
 		void setMatrix4(const std::string& name, const glm::mat4& matrix);
+		bool setUniformBlockBinding(const std::string& blockName, const GLuint bindingPoint);
+
+		template<class T>
+		UniformHandle<T> getUniform(const std::string& name) const;
+		template<class T>
+		void setUniform(const UniformHandle<T> handle, const T& value);
 
 		ShaderProgram() = delete;
 		ShaderProgram(ShaderProgram&) = delete;
@@ -21,9 +94,52 @@ namespace Renderer {
 		ShaderProgram(ShaderProgram&& shaderProgram) noexcept;
 
 	private:
-		bool createShader(const std::string& source, const GLenum shaderType, GLuint& shaderID);
+		struct Uniform {
+			GLint location;
+			GLenum type;
+			bool hasValue;
+			alignas(16) unsigned char value[sizeof(glm::mat4)];
+		};
+
+		void reflectUniforms();
+		int findUniform(const std::string& name) const;
 
 		bool m_isCompiled = false;
 		GLuint m_ID = NULL;
+		std::vector<Uniform> m_uniforms;
+		std::unordered_map<std::string, int> m_uniformsIndices;
 	};
-}
\ No newline at end of file
+
+	template<class T>
+	UniformHandle<T> ShaderProgram::getUniform(const std::string& name) const
+	{
+		static_assert(sizeof(T) <= sizeof(Uniform::value), "uniform value doesn't fit the cache");
+
+		const int index = findUniform(name);
+		if (index < 0 || !UniformTraits<T>::accepts(m_uniforms[index].type))
+		{
+			return UniformHandle<T>();
+		}
+		return UniformHandle<T>(m_ID, index);
+	}
+
+	template<class T>
+	void ShaderProgram::setUniform(const UniformHandle<T> handle, const T& value)
+	{
+		if (!handle.isValid())
+		{
+			return;
+		}
+		assert(handle.m_program == m_ID && "uniform handle of another program");
+
+		Uniform& uniform = m_uniforms[handle.m_index];
+		if (uniform.hasValue && std::memcmp(uniform.value, &value, sizeof(T)) == 0)
+		{
+			return;
+		}
+
+		std::memcpy(uniform.value, &value, sizeof(T));
+		uniform.hasValue = true;
+		RenderBackend::current().uploadUniform(m_ID, uniform.location, uniform.type, uniform.value);
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <mutex>
+
+namespace Renderer {
+
+	// Triple buffer handing whole frames from a producer (the update) to a
+	// consumer (the render). The producer fills writeBuffer() and publishes
+	// it, the consumer acquires the latest published one; neither ever waits
+	// for the other to finish with a buffer, the lock only covers swapping
+	// indices. Used from one thread the same calls work in sequence.
+	template <typename T>
+	class SnapshotBuffer {
+	public:
+		T& writeBuffer() { return m_buffers[m_writeIndex]; }
+		const T& readBuffer() const { return m_buffers[m_readIndex]; }
+
+		void publish()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				std::swap(m_writeIndex, m_readyIndex);
+				m_isReadyNew = true;
+			}
+			m_condition.notify_all();
+		}
+
+		// switches to the latest published buffer, false if there is none since the last call
+		bool acquire()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (!m_isReadyNew)
+				{
+					return false;
+				}
+				std::swap(m_readIndex, m_readyIndex);
+				m_isReadyNew = false;
+			}
+			m_condition.notify_all();
+			return true;
+		}
+
+		// blocks until a buffer is published, false once stopped
+		bool waitAndAcquire()
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this] { return m_isReadyNew || m_isStopped; });
+				if (m_isStopped)
+				{
+					return false;
+				}
+				std::swap(m_readIndex, m_readyIndex);
+				m_isReadyNew = false;
+			}
+			m_condition.notify_all();
+			return true;
+		}
+
+		// producer side: blocks until the last published buffer is taken, so it runs at most one frame ahead
+		void waitUntilAcquired()
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this] { return !m_isReadyNew || m_isStopped; });
+		}
+
+		// releases both sides for good
+		void stop()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_isStopped = true;
+			}
+			m_condition.notify_all();
+		}
+
+	private:
+		std::array<T, 3> m_buffers;
+		size_t m_writeIndex = 0;
+		size_t m_readyIndex = 1;
+		size_t m_readIndex = 2;
+		bool m_isReadyNew = false;
+		bool m_isStopped = false;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+	};
+
+}
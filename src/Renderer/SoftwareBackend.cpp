@@ -0,0 +1,16 @@
+#include "SoftwareBackend.hpp"
+
+namespace Renderer {
+
+	SoftwareBackend::SoftwareBackend(const unsigned int width, const unsigned int height, const unsigned int threadsCount) :
+		m_renderer(width, height, threadsCount)
+	{
+	}
+
+	void SoftwareBackend::drawQueue(const RenderQueue& renderQueue, const glm::vec2& viewOrigin)
+	{
+		m_renderer.clear();
+		m_renderer.draw(renderQueue, viewOrigin);
+	}
+
+}
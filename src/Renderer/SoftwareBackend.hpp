@@ -0,0 +1,46 @@
+#pragma once
+
+#include "RenderBackend.hpp"
+#include "SoftwareRenderer.hpp"
+
+namespace Renderer {
+
+	// Draws queued frames with the SoftwareRenderer. Needs no GL context:
+	// textures are read from the pixel copy Texture2D keeps, shaders are
+	// only named. Sprites drawn immediately with Sprite::render are ignored.
+	class SoftwareBackend : public RenderBackend {
+	public:
+		SoftwareBackend(const unsigned int width, const unsigned int height, const unsigned int threadsCount = 1);
+
+		EType type() const override { return EType::Software; }
+
+		GLuint createTexture(const GLuint,
+							 const GLuint,
+							 const GLenum,
+							 const std::vector<const unsigned char*>&,
+							 const GLuint,
+							 const GLenum) override { return ++m_lastName; }
+		void deleteTexture(const GLuint) override {}
+		void bindTexture(const GLuint, const GLuint) override {}
+		bool needsCpuPixels() const override { return true; }
+
+		GLuint createProgram(const std::string&, const std::string&) override { return ++m_lastName; }
+		void deleteProgram(const GLuint) override {}
+		void useProgram(const GLuint) override {}
+		std::vector<UniformDescription> activeUniforms(const GLuint) override { return {}; }
+		void uploadUniform(const GLuint, const GLint, const GLenum, const void*) override {}
+		bool setUniformBlockBinding(const GLuint, const std::string&, const GLuint) override { return true; }
+
+		void drawSpriteQuad() override {}
+		// clears the target and draws the queue into it
+		void drawQueue(const RenderQueue& renderQueue, const glm::vec2& viewOrigin) override;
+		void releaseResources() override {}
+
+		const SoftwareRenderer& renderer() const { return m_renderer; }
+
+	private:
+		GLuint m_lastName = 0;
+		SoftwareRenderer m_renderer;
+	};
+
+}
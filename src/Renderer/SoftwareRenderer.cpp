@@ -0,0 +1,243 @@
+#include "SoftwareRenderer.hpp"
+
+#include "RenderQueue.hpp"
+#include "Texture2D.hpp"
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BATTLECITY_SSE2
+#endif
+
+namespace Renderer {
+
+	namespace {
+		// copies the texels whose alpha isn't zero
+		void blendAlphaTested(uint32_t* pDestination, const uint32_t* pSource, const size_t count)
+		{
+			size_t i = 0;
+#ifdef BATTLECITY_SSE2
+			const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+			const __m128i zero = _mm_setzero_si128();
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource + i));
+				const __m128i destination = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDestination + i));
+				const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(source, alphaMask), zero);
+				const __m128i result = _mm_or_si128(_mm_and_si128(transparent, destination), _mm_andnot_si128(transparent, source));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i), result);
+			}
+#endif
+			for (; i < count; ++i)
+			{
+				if (pSource[i] & 0xFF000000u)
+				{
+					pDestination[i] = pSource[i];
+				}
+			}
+		}
+	}
+
+	SoftwareRenderer::SoftwareRenderer(const unsigned int width, const unsigned int height, const unsigned int threadsCount) :
+		m_width(width),
+		m_height(height),
+		m_tilesCountX((width + TILE_SIZE - 1) / TILE_SIZE),
+		m_tilesCountY((height + TILE_SIZE - 1) / TILE_SIZE),
+		m_pixels(static_cast<size_t>(width) * height, 0),
+		m_tileBlits(static_cast<size_t>(m_tilesCountX) * m_tilesCountY),
+		m_workers(threadsCount)
+	{
+		m_rowTexels.assign(m_workers.threadsCount(), std::vector<uint32_t>(TILE_SIZE));
+	}
+
+	void SoftwareRenderer::clear(const uint32_t color)
+	{
+		std::fill(m_pixels.begin(), m_pixels.end(), color);
+	}
+
+	bool SoftwareRenderer::prepareBlit(const RenderQueue& renderQueue, const size_t commandIndex, const glm::vec2& viewOrigin, Blit& blit)
+	{
+		const RenderQueue::Command& command = renderQueue.command(commandIndex);
+		const SpriteInstance& instance = command.instance;
+		const Texture2D& texture = *command.pTexture;
+		const Texture2D::SubTexture2D& subTexture = instance.subTexture;
+
+		const int columnsCount = static_cast<int>(std::lround(instance.size.x));
+		const int rowsCount = static_cast<int>(std::lround(instance.size.y));
+		if (columnsCount <= 0 || rowsCount <= 0 || subTexture.layer >= texture.layersCount())
+		{
+			return false;
+		}
+
+		// rotation is counterclockwise around the center, like Sprite::render
+		const long quarterTurns = std::lround(instance.rotation / 90.f) % 4;
+		blit.quarterTurns = static_cast<unsigned int>(quarterTurns < 0 ? quarterTurns + 4 : quarterTurns);
+		blit.width = blit.quarterTurns % 2 ? rowsCount : columnsCount;
+		blit.height = blit.quarterTurns % 2 ? columnsCount : rowsCount;
+
+		const glm::vec2 center = instance.position - viewOrigin + 0.5f * instance.size;
+		blit.left = static_cast<int>(std::lround(center.x - 0.5f * blit.width));
+		blit.bottom = static_cast<int>(std::lround(center.y - 0.5f * blit.height));
+		if (blit.left >= static_cast<int>(m_width) || blit.bottom >= static_cast<int>(m_height) || blit.left + blit.width <= 0 || blit.bottom + blit.height <= 0)
+		{
+			return false;
+		}
+
+		blit.pTexels = texture.pixels(subTexture.layer);
+		if (!blit.pTexels)
+		{
+			// made while another backend was current
+			return false;
+		}
+		blit.textureWidth = texture.width();
+		blit.columnsCount = static_cast<uint32_t>(columnsCount);
+		blit.rowsCount = static_cast<uint32_t>(rowsCount);
+
+		// nearest texel for every sprite column and row, an integer scale repeats texels exactly
+		const float textureLeft = subTexture.leftBottomUV.x * texture.width();
+		const float textureBottom = subTexture.leftBottomUV.y * texture.height();
+		const float columnStep = (subTexture.rightTopUV.x - subTexture.leftBottomUV.x) * texture.width() / columnsCount;
+		const float rowStep = (subTexture.rightTopUV.y - subTexture.leftBottomUV.y) * texture.height() / rowsCount;
+
+		blit.mapOffset = static_cast<uint32_t>(m_texelMaps.size());
+		for (int column = 0; column < columnsCount; ++column)
+		{
+			const int texelX = static_cast<int>(textureLeft + (column + 0.5f) * columnStep);
+			m_texelMaps.push_back(static_cast<uint32_t>(glm::clamp(texelX, 0, static_cast<int>(texture.width()) - 1)));
+		}
+		for (int row = 0; row < rowsCount; ++row)
+		{
+			const int texelY = static_cast<int>(textureBottom + (row + 0.5f) * rowStep);
+			m_texelMaps.push_back(static_cast<uint32_t>(glm::clamp(texelY, 0, static_cast<int>(texture.height()) - 1)));
+		}
+		return true;
+	}
+
+	void SoftwareRenderer::draw(const RenderQueue& renderQueue, const glm::vec2& viewOrigin)
+	{
+		m_blits.clear();
+		m_texelMaps.clear();
+		for (auto& tileBlits : m_tileBlits)
+		{
+			tileBlits.clear();
+		}
+
+		Blit blit{};
+		for (size_t i = 0; i < renderQueue.size(); ++i)
+		{
+			if (!prepareBlit(renderQueue, i, viewOrigin, blit))
+			{
+				continue;
+			}
+
+			const uint32_t blitIndex = static_cast<uint32_t>(m_blits.size());
+			m_blits.push_back(blit);
+
+			const unsigned int firstTileX = static_cast<unsigned int>(std::max(blit.left, 0)) / TILE_SIZE;
+			const unsigned int firstTileY = static_cast<unsigned int>(std::max(blit.bottom, 0)) / TILE_SIZE;
+			const unsigned int lastTileX = static_cast<unsigned int>(std::min(blit.left + blit.width, static_cast<int>(m_width)) - 1) / TILE_SIZE;
+			const unsigned int lastTileY = static_cast<unsigned int>(std::min(blit.bottom + blit.height, static_cast<int>(m_height)) - 1) / TILE_SIZE;
+			for (unsigned int tileY = firstTileY; tileY <= lastTileY; ++tileY)
+			{
+				for (unsigned int tileX = firstTileX; tileX <= lastTileX; ++tileX)
+				{
+					m_tileBlits[static_cast<size_t>(tileY) * m_tilesCountX + tileX].push_back(blitIndex);
+				}
+			}
+		}
+
+		// tiles don't overlap, so workers never touch the same pixels
+		std::atomic<size_t> nextTile(0);
+		const unsigned int workersCount = std::min<unsigned int>(m_workers.threadsCount(), static_cast<unsigned int>(m_tileBlits.size()));
+		m_workers.run(workersCount, [this, &nextTile](const unsigned int worker) {
+			for (size_t tile = nextTile++; tile < m_tileBlits.size(); tile = nextTile++)
+			{
+				drawTile(tile, m_rowTexels[worker]);
+			}
+		});
+	}
+
+	void SoftwareRenderer::drawTile(const size_t tileIndex, std::vector<uint32_t>& rowTexels)
+	{
+		const int tileLeft = static_cast<int>((tileIndex % m_tilesCountX) * TILE_SIZE);
+		const int tileBottom = static_cast<int>((tileIndex / m_tilesCountX) * TILE_SIZE);
+		const int tileRight = std::min(tileLeft + static_cast<int>(TILE_SIZE), static_cast<int>(m_width));
+		const int tileTop = std::min(tileBottom + static_cast<int>(TILE_SIZE), static_cast<int>(m_height));
+
+		for (const uint32_t blitIndex : m_tileBlits[tileIndex])
+		{
+			drawBlit(m_blits[blitIndex], tileLeft, tileBottom, tileRight, tileTop, rowTexels);
+		}
+	}
+
+	void SoftwareRenderer::drawBlit(const Blit& blit, const int tileLeft, const int tileBottom, const int tileRight, const int tileTop, std::vector<uint32_t>& rowTexels)
+	{
+		const int left = std::max(blit.left, tileLeft);
+		const int right = std::min(blit.left + blit.width, tileRight);
+		const int bottom = std::max(blit.bottom, tileBottom);
+		const int top = std::min(blit.bottom + blit.height, tileTop);
+		if (left >= right || bottom >= top)
+		{
+			return;
+		}
+
+		const uint32_t* pColumnTexels = m_texelMaps.data() + blit.mapOffset;
+		const uint32_t* pRowTexels = pColumnTexels + blit.columnsCount;
+		const int lastColumn = static_cast<int>(blit.columnsCount) - 1;
+		const int lastRow = static_cast<int>(blit.rowsCount) - 1;
+		const size_t count = static_cast<size_t>(right - left);
+
+		for (int y = bottom; y < top; ++y)
+		{
+			const int v = y - blit.bottom;
+			// gather the span's texels in sprite orientation, then blend it as one run
+			switch (blit.quarterTurns)
+			{
+			case 0:
+			{
+				const uint32_t* pTexelsRow = blit.pTexels + static_cast<size_t>(pRowTexels[v]) * blit.textureWidth;
+				for (size_t i = 0; i < count; ++i)
+				{
+					rowTexels[i] = pTexelsRow[pColumnTexels[left - blit.left + i]];
+				}
+				break;
+			}
+			case 1:
+			{
+				const uint32_t texelX = pColumnTexels[v];
+				for (size_t i = 0; i < count; ++i)
+				{
+					rowTexels[i] = blit.pTexels[static_cast<size_t>(pRowTexels[lastRow - (left - blit.left + static_cast<int>(i))]) * blit.textureWidth + texelX];
+				}
+				break;
+			}
+			case 2:
+			{
+				const uint32_t* pTexelsRow = blit.pTexels + static_cast<size_t>(pRowTexels[lastRow - v]) * blit.textureWidth;
+				for (size_t i = 0; i < count; ++i)
+				{
+					rowTexels[i] = pTexelsRow[pColumnTexels[lastColumn - (left - blit.left + static_cast<int>(i))]];
+				}
+				break;
+			}
+			default:
+			{
+				const uint32_t texelX = pColumnTexels[lastColumn - v];
+				for (size_t i = 0; i < count; ++i)
+				{
+					rowTexels[i] = blit.pTexels[static_cast<size_t>(pRowTexels[left - blit.left + i]) * blit.textureWidth + texelX];
+				}
+				break;
+			}
+			}
+
+			blendAlphaTested(m_pixels.data() + static_cast<size_t>(y) * m_width + left, rowTexels.data(), count);
+		}
+	}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "WorkerPool.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Renderer {
+
+	class RenderQueue;
+
+	// CPU rasterizer for the sorted output of a RenderQueue, for running many
+	// game instances where a GL context each is too expensive. Sprites are
+	// drawn as alpha-tested nearest-neighbour blits with rotation snapped to
+	// 90 degrees, which is all the pixel art needs. The target is split into
+	// tiles; commands are binned per tile and tiles are drawn in parallel by
+	// workers that live as long as the renderer.
+	class SoftwareRenderer {
+	public:
+		static constexpr unsigned int TILE_SIZE = 64;
+
+		// threadsCount 0 uses one thread per hardware thread
+		SoftwareRenderer(const unsigned int width, const unsigned int height, const unsigned int threadsCount = 1);
+
+		SoftwareRenderer(const SoftwareRenderer&) = delete;
+		SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+
+		// color is RGBA packed as in pixels()
+		void clear(const uint32_t color = 0);
+		// the queue must be sorted; uses the same coordinates as the GL projection: pixels, origin bottom
+		// left, with viewOrigin at the bottom-left pixel
+		void draw(const RenderQueue& renderQueue, const glm::vec2& viewOrigin = glm::vec2(0.f));
+
+		// RGBA rows, bottom row first, like FrameBuffer::readPixels
+		const std::vector<uint32_t>& pixels() const { return m_pixels; }
+		unsigned int width() const { return m_width; }
+		unsigned int height() const { return m_height; }
+
+	private:
+		struct Blit {
+			const uint32_t* pTexels;
+			unsigned int textureWidth;
+			int left;
+			int bottom;
+			int width;
+			int height;
+			unsigned int quarterTurns;
+			// texel column/row for every column/row of the unrotated sprite
+			uint32_t mapOffset;
+			uint32_t columnsCount;
+			uint32_t rowsCount;
+		};
+
+		bool prepareBlit(const RenderQueue& renderQueue, const size_t commandIndex, const glm::vec2& viewOrigin, Blit& blit);
+		void drawTile(const size_t tileIndex, std::vector<uint32_t>& rowTexels);
+		void drawBlit(const Blit& blit, const int tileLeft, const int tileBottom, const int tileRight, const int tileTop, std::vector<uint32_t>& rowTexels);
+
+		unsigned int m_width;
+		unsigned int m_height;
+		unsigned int m_tilesCountX;
+		unsigned int m_tilesCountY;
+		std::vector<uint32_t> m_pixels;
+		std::vector<Blit> m_blits;
+		std::vector<uint32_t> m_texelMaps;
+		std::vector<std::vector<uint32_t>> m_tileBlits;
+		// one row of texels per worker
+		std::vector<std::vector<uint32_t>> m_rowTexels;
+		WorkerPool m_workers;
+	};
+
+}
@@ -2,7 +2,11 @@
 
 #include "ShaderProgram.hpp"
 #include "Texture2D.hpp"
+#include "SpriteBatch.hpp"
+#include "RenderQueue.hpp"
+#include "RenderBackend.hpp"
 #include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
 #include "glm/gtc/matrix_transform.hpp"
 
 namespace Renderer {
@@ -15,96 +19,55 @@ namespace Renderer {
 					   const float rotation) :
 			m_pTexture(std::move(pTexture)),
 			m_pShaderProgram(std::move(pShaderProgram)),
-			m_position(position),
-			m_size(size),
-			m_rotation(rotation)
+			m_instance{ position, size, rotation, m_pTexture->getSubTexture(std::move(initialSubTexture)) },
+			m_modelMatUniform(m_pShaderProgram->getUniform<glm::mat4>("modelMat")),
+			m_uvRectUniform(m_pShaderProgram->getUniform<glm::vec4>("uvRect")),
+			m_layerUniform(m_pShaderProgram->getUniform<GLfloat>("layer"))
 		{
-			const GLfloat vertexCoords[] = {
-				// 2--3    1
-				// | /   / |
-				// 1    3--2
-
-			 // X    Y
-				0.f, 0.f,
-				0.f, 1.f,
-				1.f, 1.f,
-
-				1.f, 1.f,
-				1.f, 0.f,
-				0.f, 0.f
-			};
+		}
 
-			auto subTexture = m_pTexture->getSubTexture(std::move(initialSubTexture));
+		void Sprite::render() const
+		{
+			m_pShaderProgram->use();
 
-			const GLfloat textureCoords[] = {
-			 // U							V
-				subTexture.leftBottomUV.x,	subTexture.leftBottomUV.y,
-				subTexture.leftBottomUV.x,	subTexture.rightTopUV.y,
-				subTexture.rightTopUV.x,	subTexture.rightTopUV.y,
+			glm::mat4 model(1.f);
 
-				subTexture.rightTopUV.x,	subTexture.rightTopUV.y,
-				subTexture.rightTopUV.x,	subTexture.leftBottomUV.y,
-				subTexture.leftBottomUV.x,	subTexture.leftBottomUV.y
-			};
+			model = glm::translate(model, glm::vec3(m_instance.position, 0.f));
+			model = glm::translate(model, glm::vec3(0.5f * m_instance.size.x, 0.5f * m_instance.size.y, 0.f));
+			model = glm::rotate(model, glm::radians(m_instance.rotation), glm::vec3(0.f, 0.f, 1.f));
+			model = glm::translate(model, glm::vec3(-0.5f * m_instance.size.x, -0.5f * m_instance.size.y, 0.f));
+			model = glm::scale(model, glm::vec3(m_instance.size, 1.f));
 
-			glGenVertexArrays(1, &m_VAO);
-			glBindVertexArray(m_VAO);
+			m_pShaderProgram->setUniform(m_modelMatUniform, model);
+			m_pShaderProgram->setUniform(m_uvRectUniform, glm::vec4(m_instance.subTexture.leftBottomUV, m_instance.subTexture.rightTopUV));
+			m_pShaderProgram->setUniform(m_layerUniform, static_cast<GLfloat>(m_instance.subTexture.layer));
 
-			glGenBuffers(1, &m_vertexCoordsVBO);
-			glBindBuffer(GL_ARRAY_BUFFER, m_vertexCoordsVBO);
-			glBufferData(GL_ARRAY_BUFFER, sizeof(vertexCoords), &vertexCoords, GL_STATIC_DRAW);
-			glEnableVertexAttribArray(0);
-			glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-			
-			glGenBuffers(1, &m_textureCoordsVBO);
-			glBindBuffer(GL_ARRAY_BUFFER, m_textureCoordsVBO);
-			glBufferData(GL_ARRAY_BUFFER, sizeof(textureCoords), &textureCoords, GL_STATIC_DRAW);
-			glEnableVertexAttribArray(1);
-			glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+			m_pTexture->bind(0);
 
-			glBindBuffer(GL_ARRAY_BUFFER, NULL);
-			glBindVertexArray(NULL);
+			RenderBackend::current().drawSpriteQuad();
 		}
 
-		Sprite::~Sprite()
+		void Sprite::submit(SpriteBatch& spriteBatch) const
 		{
-			glDeleteBuffers(1, &m_vertexCoordsVBO);
-			glDeleteBuffers(1, &m_textureCoordsVBO);
-			glDeleteVertexArrays(1, &m_VAO);
+			spriteBatch.submit(m_pShaderProgram.get(), m_pTexture.get(), m_instance);
 		}
 
-		void Sprite::render() const
+		void Sprite::submit(RenderQueue& renderQueue, const ERenderLayer layer, const float depth) const
 		{
-			m_pShaderProgram->use();
-
-			glm::mat4 model(1.f);
-
-			model = glm::translate(model, glm::vec3(m_position, 0.f));
-			model = glm::translate(model, glm::vec3(0.5f * m_size.x, 0.5f * m_size.y, 0.f));
-			model = glm::rotate(model, glm::radians(m_rotation), glm::vec3(0.f, 0.f, 1.f));
-			model = glm::translate(model, glm::vec3(-0.5f * m_size.x, -0.5f * m_size.y, 0.f));
-			model = glm::scale(model, glm::vec3(m_size, 1.f));
-
-			glBindVertexArray(m_VAO);
-			m_pShaderProgram->setMatrix4("modelMat", model);
-
-			glActiveTexture(GL_TEXTURE0);
-			m_pTexture->bind();
-
-			glDrawArrays(GL_TRIANGLES, 0, 6);
-			glBindVertexArray(0);
+			renderQueue.submit(layer, depth, *m_pShaderProgram, *m_pTexture, m_instance);
 		}
+
 		void Sprite::setPosition(const glm::vec2& position)
 		{
-			m_position = position;
+			m_instance.position = position;
 		}
 		void Sprite::setSize(const glm::vec2& size)
 		{
-			m_size = size;
+			m_instance.size = size;
 		}
 		void Sprite::setRotation(const float& rotation)
 		{
-			m_rotation = rotation;
+			m_instance.rotation = rotation;
 		}
 
-}
\ No newline at end of file
+}
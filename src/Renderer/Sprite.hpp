@@ -3,13 +3,25 @@
 #include <glad/glad.h>
 #include <glm/vec2.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
+#include "Texture2D.hpp"
+#include "ShaderProgram.hpp"
+
 namespace Renderer {
 	
-	class Texture2D;
-	class ShaderProgram;
+	class SpriteBatch;
+	class RenderQueue;
+	enum class ERenderLayer : uint8_t;
+
+	struct SpriteInstance {
+		glm::vec2 position;
+		glm::vec2 size;
+		float rotation;
+		Texture2D::SubTexture2D subTexture;
+	};
 
 	class Sprite {
 	public:
@@ -20,25 +32,27 @@ namespace Renderer {
 			   const glm::vec2& size = glm::vec2(1.f),
 			   const float rotation = 0.f);
 
-		~Sprite();
+		virtual ~Sprite() = default;
 
 		Sprite(const Sprite&) = delete;
 		Sprite operator =(const Sprite&) = delete;
 
 		virtual void render() const;
+		virtual void submit(SpriteBatch& spriteBatch) const;
+		virtual void submit(RenderQueue& renderQueue, const ERenderLayer layer, const float depth = 0.f) const;
 		void setPosition(const glm::vec2& position);
 		void setSize(const glm::vec2& size);
 		void setRotation(const float& rotation);
+		const glm::vec2& position() const { return m_instance.position; }
+		const glm::vec2& size() const { return m_instance.size; }
 
 	protected:
 		std::shared_ptr<Texture2D> m_pTexture;
 		std::shared_ptr<ShaderProgram> m_pShaderProgram;
-		glm::vec2 m_position;
-		glm::vec2 m_size;
-		float m_rotation;
-		GLuint m_VAO;
-		GLuint m_vertexCoordsVBO;
-		GLuint m_textureCoordsVBO;
+		SpriteInstance m_instance;
+		UniformHandle<glm::mat4> m_modelMatUniform;
+		UniformHandle<glm::vec4> m_uvRectUniform;
+		UniformHandle<GLfloat> m_layerUniform;
 	};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,200 @@
+#include "SpriteBatch.hpp"
+
+#include "ShaderProgram.hpp"
+#include "GLStateCache.hpp"
+#include "StreamBuffer.hpp"
+#include "RenderStats.hpp"
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include <glm/common.hpp>
+#include <glm/trigonometric.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace Renderer {
+
+	namespace {
+		// farthest a vertex can be from the draw call's origin, in pixels
+		const float MAX_ORIGIN_DISTANCE = 32767.f / SpriteBatch::POSITION_SCALE;
+
+		int16_t packPosition(const float position)
+		{
+			return static_cast<int16_t>(std::lround(position * SpriteBatch::POSITION_SCALE));
+		}
+
+		uint16_t packTextureCoord(const float textureCoord)
+		{
+			return static_cast<uint16_t>(std::lround(glm::clamp(textureCoord, 0.f, 1.f) * 65535.f));
+		}
+
+		bool isNearOrigin(const glm::vec2& position, const glm::vec2& origin)
+		{
+			const glm::vec2 distance = glm::abs(position - origin);
+			return distance.x <= MAX_ORIGIN_DISTANCE && distance.y <= MAX_ORIGIN_DISTANCE;
+		}
+	}
+
+	SpriteBatch::SpriteBatch(StreamBuffer& streamBuffer, const size_t maxSprites) :
+		m_streamBuffer(streamBuffer),
+		m_maxSprites(maxSprites)
+	{
+		// 1--2
+		// | /|
+		// |/ |
+		// 0--3
+		std::vector<GLuint> indices(6 * m_maxSprites);
+		for (size_t i = 0; i < m_maxSprites; ++i)
+		{
+			const GLuint firstVertex = static_cast<GLuint>(4 * i);
+			indices[6 * i + 0] = firstVertex + 0;
+			indices[6 * i + 1] = firstVertex + 1;
+			indices[6 * i + 2] = firstVertex + 2;
+
+			indices[6 * i + 3] = firstVertex + 2;
+			indices[6 * i + 4] = firstVertex + 3;
+			indices[6 * i + 5] = firstVertex + 0;
+		}
+
+		glGenVertexArrays(1, &m_VAO);
+		GLStateCache::bindVertexArray(m_VAO);
+
+		GLStateCache::bindBuffer(GL_ARRAY_BUFFER, m_streamBuffer.id());
+
+		// positions are scaled back to pixels by the model matrix, the layer is converted to float as is
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, position)));
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, textureCoords)));
+		glEnableVertexAttribArray(2);
+		glVertexAttribPointer(2, 1, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, layer)));
+
+		glGenBuffers(1, &m_EBO);
+		GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+
+		GLStateCache::bindVertexArray(0);
+		GLStateCache::bindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	SpriteBatch::~SpriteBatch()
+	{
+		GLStateCache::deleteBuffer(m_EBO);
+		GLStateCache::deleteVertexArray(m_VAO);
+	}
+
+	size_t SpriteBatch::spriteVerticesSize()
+	{
+		return 4 * sizeof(Vertex);
+	}
+
+	void SpriteBatch::begin(const glm::vec2& viewOrigin)
+	{
+		m_viewOrigin = viewOrigin;
+		m_pVertices = nullptr;
+		m_verticesCount = 0;
+		m_pCurrentShaderProgram = nullptr;
+		m_pCurrentTexture = nullptr;
+		m_drawCallsCount = 0;
+		m_spritesCount = 0;
+	}
+
+	void SpriteBatch::submit(ShaderProgram* pShaderProgram, Texture2D* pTexture, const SpriteInstance& instance)
+	{
+		if (pShaderProgram != m_pCurrentShaderProgram || pTexture != m_pCurrentTexture || m_verticesCount == m_verticesCapacity)
+		{
+			flush();
+			if (pShaderProgram != m_pCurrentShaderProgram)
+			{
+				m_modelMatUniform = pShaderProgram->getUniform<glm::mat4>("modelMat");
+				m_uvRectUniform = pShaderProgram->getUniform<glm::vec4>("uvRect");
+				m_layerUniform = pShaderProgram->getUniform<GLfloat>("layer");
+			}
+			m_pCurrentShaderProgram = pShaderProgram;
+			m_pCurrentTexture = pTexture;
+		}
+
+		// same transform as Sprite::render: rotation around the sprite center
+		const glm::vec2 halfSize = 0.5f * instance.size;
+		const glm::vec2 center = instance.position + halfSize;
+		const float radians = glm::radians(instance.rotation);
+		const float cosAngle = glm::cos(radians);
+		const float sinAngle = glm::sin(radians);
+		const glm::vec2 axisX(cosAngle * halfSize.x, sinAngle * halfSize.x);
+		const glm::vec2 axisY(-sinAngle * halfSize.y, cosAngle * halfSize.y);
+		const glm::vec2 corners[4] = { center - axisX - axisY, center - axisX + axisY, center + axisX + axisY, center + axisX - axisY };
+
+		// out of 16-bit range of the current draw call's origin: start a new one around this sprite
+		if (m_verticesCount > 0 && !std::all_of(std::begin(corners), std::end(corners), [this](const glm::vec2& corner) { return isNearOrigin(corner, m_origin); }))
+		{
+			flush();
+		}
+		if (!m_pVertices)
+		{
+			GLintptr offset = 0;
+			GLsizeiptr size = 0;
+			m_pVertices = static_cast<Vertex*>(m_streamBuffer.reserve(4 * sizeof(Vertex), 4 * m_maxSprites * sizeof(Vertex), 4 * sizeof(Vertex), offset, size));
+			if (!m_pVertices)
+			{
+				return;
+			}
+			m_baseVertex = static_cast<GLint>(offset / sizeof(Vertex));
+			m_verticesCapacity = size / sizeof(Vertex);
+			m_origin = glm::floor(center);
+		}
+
+		const Texture2D::SubTexture2D& subTexture = instance.subTexture;
+		const uint16_t left = packTextureCoord(subTexture.leftBottomUV.x);
+		const uint16_t bottom = packTextureCoord(subTexture.leftBottomUV.y);
+		const uint16_t right = packTextureCoord(subTexture.rightTopUV.x);
+		const uint16_t top = packTextureCoord(subTexture.rightTopUV.y);
+		const uint16_t layer = static_cast<uint16_t>(subTexture.layer);
+		const uint16_t textureCoords[4][2] = { { left, bottom }, { left, top }, { right, top }, { right, bottom } };
+		Vertex* pVertex = m_pVertices + m_verticesCount;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			const glm::vec2 position = corners[i] - m_origin;
+			pVertex[i] = { { packPosition(position.x), packPosition(position.y) }, { textureCoords[i][0], textureCoords[i][1] }, layer };
+		}
+		m_verticesCount += 4;
+		++m_spritesCount;
+	}
+
+	void SpriteBatch::end()
+	{
+		flush();
+	}
+
+	void SpriteBatch::flush()
+	{
+		if (m_verticesCount == 0)
+		{
+			m_pVertices = nullptr;
+			return;
+		}
+
+		m_streamBuffer.commit(m_verticesCount * sizeof(Vertex));
+
+		m_pCurrentShaderProgram->use();
+		// vertices are fixed point around m_origin with final texture coordinates, the view origin moves them to the screen
+		const glm::mat4 modelMatrix = glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(m_origin - m_viewOrigin, 0.f)), glm::vec3(1.f / POSITION_SCALE, 1.f / POSITION_SCALE, 1.f));
+		m_pCurrentShaderProgram->setUniform(m_modelMatUniform, modelMatrix);
+		m_pCurrentShaderProgram->setUniform(m_uvRectUniform, glm::vec4(0.f, 0.f, 1.f, 1.f));
+		m_pCurrentShaderProgram->setUniform(m_layerUniform, 0.f);
+
+		m_pCurrentTexture->bind(0);
+
+		// the mapping is coherent, so the data is visible to the draw without an upload
+		GLStateCache::bindVertexArray(m_VAO);
+		glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(m_verticesCount / 4 * 6), GL_UNSIGNED_INT, nullptr, m_baseVertex);
+		RenderStats::addDraw(m_verticesCount / 4 * 6);
+
+		++m_drawCallsCount;
+		m_pVertices = nullptr;
+		m_verticesCount = 0;
+	}
+
+}
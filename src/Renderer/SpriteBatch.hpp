@@ -0,0 +1,69 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+
+#include "Sprite.hpp"
+
+namespace Renderer {
+
+	class StreamBuffer;
+
+	class SpriteBatch {
+	public:
+		SpriteBatch(StreamBuffer& streamBuffer, const size_t maxSprites = 10000);
+		~SpriteBatch();
+
+		SpriteBatch(const SpriteBatch&) = delete;
+		SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+		// viewOrigin is subtracted from every sprite position, for queues recorded in world space
+		void begin(const glm::vec2& viewOrigin = glm::vec2(0.f));
+		void submit(ShaderProgram* pShaderProgram, Texture2D* pTexture, const SpriteInstance& instance);
+		void end();
+
+		size_t drawCallsCount() const { return m_drawCallsCount; }
+		size_t spritesCount() const { return m_spritesCount; }
+
+		// stream buffer bytes taken by one quad
+		static size_t spriteVerticesSize();
+
+		// vertex positions are fixed point with this many steps per pixel,
+		// relative to an origin taken per draw call
+		static constexpr float POSITION_SCALE = 8.f;
+
+	private:
+		// 10 bytes: positions and texture coordinates as 16-bit integers, the
+		// coordinates normalized by the vertex fetch
+		struct Vertex {
+			int16_t position[2];
+			uint16_t textureCoords[2];
+			uint16_t layer;
+		};
+
+		void flush();
+
+		StreamBuffer& m_streamBuffer;
+		// vertices go straight into the stream buffer's mapped memory
+		Vertex* m_pVertices = nullptr;
+		size_t m_verticesCount = 0;
+		size_t m_verticesCapacity = 0;
+		GLint m_baseVertex = 0;
+		// world position the vertices of the current draw call are relative to
+		glm::vec2 m_origin = glm::vec2(0.f);
+		glm::vec2 m_viewOrigin = glm::vec2(0.f);
+		ShaderProgram* m_pCurrentShaderProgram = nullptr;
+		Texture2D* m_pCurrentTexture = nullptr;
+		UniformHandle<glm::mat4> m_modelMatUniform;
+		UniformHandle<glm::vec4> m_uvRectUniform;
+		UniformHandle<GLfloat> m_layerUniform;
+		size_t m_maxSprites;
+		size_t m_drawCallsCount = 0;
+		size_t m_spritesCount = 0;
+		GLuint m_VAO = 0;
+		GLuint m_EBO = 0;
+	};
+
+}
@@ -0,0 +1,66 @@
+#include "SpriteQuad.hpp"
+#include "GLStateCache.hpp"
+
+namespace Renderer {
+
+	GLuint SpriteQuad::m_VAO = 0;
+	GLuint SpriteQuad::m_VBO = 0;
+
+	namespace {
+		const GLfloat QUAD_VERTICES[] = {
+			// 2--3    1
+			// | /   / |
+			// 1    3--2
+
+		 // X    Y
+			0.f, 0.f,
+			0.f, 1.f,
+			1.f, 1.f,
+
+			1.f, 1.f,
+			1.f, 0.f,
+			0.f, 0.f
+		};
+	}
+
+	void SpriteQuad::create()
+	{
+		glGenVertexArrays(1, &m_VAO);
+		GLStateCache::bindVertexArray(m_VAO);
+
+		glGenBuffers(1, &m_VBO);
+		GLStateCache::bindBuffer(GL_ARRAY_BUFFER, m_VBO);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(QUAD_VERTICES), &QUAD_VERTICES, GL_STATIC_DRAW);
+
+		// the unit quad doubles as texture coordinates, remapped by the uvRect uniform
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+		GLStateCache::bindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void SpriteQuad::bind()
+	{
+		if (!m_VAO)
+		{
+			create();
+		}
+		GLStateCache::bindVertexArray(m_VAO);
+	}
+
+	void SpriteQuad::release()
+	{
+		GLStateCache::deleteBuffer(m_VBO);
+		GLStateCache::deleteVertexArray(m_VAO);
+		m_VBO = 0;
+		m_VAO = 0;
+	}
+
+	size_t SpriteQuad::memoryUsage()
+	{
+		return sizeof(QUAD_VERTICES);
+	}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+
+namespace Renderer {
+
+	// Unit quad geometry shared by every sprite. Created on the first bind,
+	// so constructing and destroying sprites makes no GL calls.
+	class SpriteQuad {
+	public:
+		static void bind();
+		static void release();
+
+		static size_t memoryUsage();
+
+		static constexpr GLsizei VERTICES_COUNT = 6;
+
+		SpriteQuad() = delete;
+		~SpriteQuad() = delete;
+
+	private:
+		static void create();
+
+		static GLuint m_VAO;
+		static GLuint m_VBO;
+	};
+
+}
@@ -0,0 +1,123 @@
+#include "StreamBuffer.hpp"
+
+#include "GLStateCache.hpp"
+#include "RenderStats.hpp"
+#include "GLTraceRecorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace Renderer {
+
+	StreamBuffer::StreamBuffer(const GLenum target, const GLsizeiptr regionSize, const unsigned int regionsCount) :
+		m_target(target),
+		m_regionSize(regionSize),
+		m_fences(regionsCount, nullptr)
+	{
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		const GLsizeiptr size = m_regionSize * static_cast<GLsizeiptr>(regionsCount);
+
+		glGenBuffers(1, &m_ID);
+		GLStateCache::bindBuffer(m_target, m_ID);
+		glBufferStorage(m_target, size, nullptr, flags);
+		m_pMapping = static_cast<unsigned char*>(glMapBufferRange(m_target, 0, size, flags));
+
+		if (!m_pMapping)
+		{
+			std::cerr << "Can't map the stream buffer of " << size << " bytes" << std::endl;
+		}
+	}
+
+	StreamBuffer::~StreamBuffer()
+	{
+		for (GLsync fence : m_fences)
+		{
+			glDeleteSync(fence);
+		}
+		if (m_pMapping)
+		{
+			GLStateCache::bindBuffer(m_target, m_ID);
+			glUnmapBuffer(m_target);
+		}
+		GLStateCache::deleteBuffer(m_ID);
+	}
+
+	void* StreamBuffer::reserve(const GLsizeiptr minSize,
+								const GLsizeiptr maxSize,
+								const GLsizeiptr alignment,
+								GLintptr& offset,
+								GLsizeiptr& size)
+	{
+		if (!m_pMapping || minSize > m_regionSize)
+		{
+			return nullptr;
+		}
+
+		// align the offset in the whole buffer: regions don't start at multiples of every alignment
+		GLintptr regionStart = m_currentRegion * m_regionSize;
+		GLintptr alignedOffset = (regionStart + m_regionOffset + alignment - 1) / alignment * alignment - regionStart;
+		if (alignedOffset + minSize > m_regionSize)
+		{
+			// the region is full before the frame ends: fence it and wait for the next one
+			GLsync& fence = m_fences[m_currentRegion];
+			glDeleteSync(fence);
+			fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			nextRegion();
+			regionStart = m_currentRegion * m_regionSize;
+			alignedOffset = (regionStart + alignment - 1) / alignment * alignment - regionStart;
+		}
+
+		size = std::min<GLsizeiptr>(maxSize, (m_regionSize - alignedOffset) / alignment * alignment);
+		m_reservedOffset = alignedOffset;
+		offset = regionStart + alignedOffset;
+		return m_pMapping + offset;
+	}
+
+	void StreamBuffer::commit(const GLsizeiptr usedSize)
+	{
+		m_regionOffset = m_reservedOffset + usedSize;
+		if (usedSize > 0)
+		{
+			// written through the mapping, but it's still traffic to the GPU
+			RenderStats::addUpload(static_cast<size_t>(usedSize));
+			const GLintptr bufferOffset = m_currentRegion * m_regionSize + m_reservedOffset;
+			GLTraceRecorder::recordMappedWrite(m_ID, bufferOffset, usedSize, m_pMapping + bufferOffset);
+		}
+	}
+
+	void StreamBuffer::endFrame()
+	{
+		GLsync& fence = m_fences[m_currentRegion];
+		glDeleteSync(fence);
+		fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		nextRegion();
+
+		m_lastFrameFenceWaitTime = m_frameFenceWaitTime;
+		m_frameFenceWaitTime = 0.0;
+	}
+
+	void StreamBuffer::nextRegion()
+	{
+		m_currentRegion = (m_currentRegion + 1) % m_fences.size();
+		m_regionOffset = 0;
+
+		GLsync& fence = m_fences[m_currentRegion];
+		if (!fence)
+		{
+			return;
+		}
+
+		auto startTime = std::chrono::high_resolution_clock::now();
+		GLenum waitResult = glClientWaitSync(fence, 0, 0);
+		while (waitResult == GL_TIMEOUT_EXPIRED)
+		{
+			waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+		}
+		m_frameFenceWaitTime += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <vector>
+
+namespace Renderer {
+
+	// Persistently mapped, coherent buffer split into regions (one per frame
+	// in flight). Geometry is written straight into the mapping; a region is
+	// reused only after the fence placed when it was left has signaled.
+	class StreamBuffer {
+	public:
+		StreamBuffer(const GLenum target, const GLsizeiptr regionSize, const unsigned int regionsCount = 3);
+		~StreamBuffer();
+
+		StreamBuffer() = delete;
+		StreamBuffer(const StreamBuffer&) = delete;
+		StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+		// Returns a write pointer to between minSize and maxSize bytes aligned to
+		// alignment, or nullptr if minSize doesn't fit in a region. Moves to the
+		// next region when the current one is too full. Follow with commit().
+		void* reserve(const GLsizeiptr minSize,
+					  const GLsizeiptr maxSize,
+					  const GLsizeiptr alignment,
+					  GLintptr& offset,
+					  GLsizeiptr& size);
+		void commit(const GLsizeiptr usedSize);
+
+		// fences the frame's region and moves on to the next one
+		void endFrame();
+
+		GLuint id() const { return m_ID; }
+		GLenum target() const { return m_target; }
+		double lastFrameFenceWaitTime() const { return m_lastFrameFenceWaitTime; }
+
+	private:
+		void nextRegion();
+
+		GLuint m_ID = 0;
+		GLenum m_target;
+		GLsizeiptr m_regionSize;
+		unsigned char* m_pMapping = nullptr;
+		std::vector<GLsync> m_fences;
+		unsigned int m_currentRegion = 0;
+		GLintptr m_regionOffset = 0;
+		GLintptr m_reservedOffset = 0;
+		double m_frameFenceWaitTime = 0.0;
+		double m_lastFrameFenceWaitTime = 0.0;
+	};
+
+}
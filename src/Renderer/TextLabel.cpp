@@ -0,0 +1,91 @@
+#include "TextLabel.hpp"
+
+#include "BitmapFont.hpp"
+#include "RenderQueue.hpp"
+#include "SpriteBatch.hpp"
+
+namespace Renderer {
+
+	TextLabel::TextLabel(std::shared_ptr<BitmapFont> pFont,
+						 std::shared_ptr<ShaderProgram> pShaderProgram,
+						 const glm::vec2& position,
+						 const float scale,
+						 const size_t reserveLength) :
+		m_pFont(std::move(pFont)),
+		m_pShaderProgram(std::move(pShaderProgram)),
+		m_position(position),
+		m_scale(scale)
+	{
+		m_text.reserve(reserveLength);
+		m_glyphs.reserve(reserveLength);
+	}
+
+	void TextLabel::setText(const std::string_view text)
+	{
+		if (text == m_text)
+		{
+			return;
+		}
+
+		m_text.assign(text.data(), text.size());
+		layout();
+	}
+
+	void TextLabel::setPosition(const glm::vec2& position)
+	{
+		if (position == m_position)
+		{
+			return;
+		}
+
+		m_position = position;
+		layout();
+	}
+
+	glm::vec2 TextLabel::size() const
+	{
+		return m_pFont->measure(m_text, m_scale);
+	}
+
+	void TextLabel::layout()
+	{
+		m_glyphs.clear();
+		++m_layoutsCount;
+
+		const glm::vec2 glyphSize = m_scale * glm::vec2(BitmapFont::GLYPH_WIDTH, BitmapFont::GLYPH_HEIGHT);
+		glm::vec2 glyphPosition(m_position.x, m_position.y - glyphSize.y);
+		for (const char character : m_text)
+		{
+			if (character == '\n')
+			{
+				glyphPosition = glm::vec2(m_position.x, glyphPosition.y - m_scale * BitmapFont::LINE_HEIGHT);
+				continue;
+			}
+			if (!BitmapFont::isBlank(character))
+			{
+				m_glyphs.push_back(SpriteInstance{ glyphPosition, glyphSize, 0.f, m_pFont->glyph(character) });
+			}
+			glyphPosition.x += m_scale * BitmapFont::ADVANCE;
+		}
+	}
+
+	void TextLabel::submit(RenderQueue& renderQueue, const ERenderLayer layer, const glm::vec2& offset) const
+	{
+		Texture2D& texture = *m_pFont->texture();
+		for (SpriteInstance glyph : m_glyphs)
+		{
+			glyph.position += offset;
+			renderQueue.submit(layer, 0.f, *m_pShaderProgram, texture, glyph);
+		}
+	}
+
+	void TextLabel::submit(SpriteBatch& spriteBatch) const
+	{
+		Texture2D* pTexture = m_pFont->texture().get();
+		for (const SpriteInstance& glyph : m_glyphs)
+		{
+			spriteBatch.submit(m_pShaderProgram.get(), pTexture, glyph);
+		}
+	}
+
+}
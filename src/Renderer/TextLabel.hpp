@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Sprite.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Renderer {
+
+	class BitmapFont;
+	class ShaderProgram;
+	class RenderQueue;
+	class SpriteBatch;
+	enum class ERenderLayer : uint8_t;
+
+	// A string laid out into one sprite instance per visible glyph. The
+	// instances are kept and rebuilt only when the text or the position
+	// changes; up to reserveLength characters that never allocates, so a
+	// counter updated every frame costs a compare and a few quads.
+	class TextLabel {
+	public:
+		// position is the top left corner of the first line
+		TextLabel(std::shared_ptr<BitmapFont> pFont,
+				  std::shared_ptr<ShaderProgram> pShaderProgram,
+				  const glm::vec2& position = glm::vec2(0.f),
+				  const float scale = 1.f,
+				  const size_t reserveLength = 32);
+
+		void setText(const std::string_view text);
+		void setPosition(const glm::vec2& position);
+
+		const std::string& text() const { return m_text; }
+		const glm::vec2& position() const { return m_position; }
+		glm::vec2 size() const;
+		// times the glyph instances were rebuilt
+		size_t layoutsCount() const { return m_layoutsCount; }
+
+		// offset moves the text without a rebuild, e.g. to keep it on screen under a camera
+		void submit(RenderQueue& renderQueue, const ERenderLayer layer, const glm::vec2& offset = glm::vec2(0.f)) const;
+		void submit(SpriteBatch& spriteBatch) const;
+
+	private:
+		void layout();
+
+		std::shared_ptr<BitmapFont> m_pFont;
+		std::shared_ptr<ShaderProgram> m_pShaderProgram;
+		glm::vec2 m_position;
+		float m_scale;
+		std::string m_text;
+		std::vector<SpriteInstance> m_glyphs;
+		size_t m_layoutsCount = 0;
+	};
+
+}
@@ -1,4 +1,7 @@
 #include "Texture2D.hpp"
+#include "RenderBackend.hpp"
+
+#include <cstring>
 
 namespace Renderer {
 	Texture2D::Texture2D(const GLuint width,
@@ -8,7 +11,8 @@ namespace Renderer {
 						 const GLuint filter,
 						 const GLenum wrapMode
 	) : m_width(width),
-		m_height(height)
+		m_height(height),
+		m_layersCount(1)
 	{
 		switch (channels) {
 		case 4:
@@ -22,27 +26,68 @@ namespace Renderer {
 			break;
 		}
 
-		glGenTextures(1, &m_ID);
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, m_ID);
-		glTexImage2D(GL_TEXTURE_2D, NULL, m_mode, m_width, m_height, NULL, m_mode, GL_UNSIGNED_BYTE, data);
+		create({ data }, filter, wrapMode);
+	}
+
+	Texture2D::Texture2D(const GLuint width,
+						 const GLuint height,
+						 const std::vector<const unsigned char*>& layersData,
+						 const GLuint filter,
+						 const GLenum wrapMode
+	) : m_mode(GL_RGBA),
+		m_width(width),
+		m_height(height),
+		m_layersCount(static_cast<unsigned int>(layersData.size()))
+	{
+		create(layersData, filter, wrapMode);
+	}
 
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapMode);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, wrapMode);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, wrapMode);
-		glGenerateMipmap(GL_TEXTURE_2D);
+	void Texture2D::create(const std::vector<const unsigned char*>& layersData, const GLuint filter, const GLenum wrapMode)
+	{
+		m_ID = RenderBackend::current().createTexture(m_width, m_height, m_mode, layersData, filter, wrapMode);
+		if (m_ID != 0)
+		{
+			++RenderBackend::m_objectsCount;
+		}
+		if (!RenderBackend::current().needsCpuPixels())
+		{
+			return;
+		}
 
-		glBindTexture(GL_TEXTURE_2D, NULL);
+		const size_t layerPixelsCount = static_cast<size_t>(m_width) * m_height;
+		m_pixels.resize(layerPixelsCount * m_layersCount);
+		for (unsigned int layer = 0; layer < m_layersCount; ++layer)
+		{
+			uint32_t* pLayerPixels = m_pixels.data() + layer * layerPixelsCount;
+			if (!layersData[layer])
+			{
+				continue;
+			}
+			if (m_mode == GL_RGBA)
+			{
+				std::memcpy(pLayerPixels, layersData[layer], 4 * layerPixelsCount);
+				continue;
+			}
+			for (size_t i = 0; i < layerPixelsCount; ++i)
+			{
+				const unsigned char* pPixel = layersData[layer] + 3 * i;
+				pLayerPixels[i] = pPixel[0] | (pPixel[1] << 8) | (pPixel[2] << 16) | 0xFF000000u;
+			}
+		}
 	}
 
 	Texture2D& Texture2D::operator=(Texture2D&& texture2d) noexcept {
-		glDeleteTextures(1, &m_ID);
+		if (m_ID != 0) {
+			RenderBackend::current().deleteTexture(m_ID);
+			--RenderBackend::m_objectsCount;
+		}
 		m_ID = texture2d.m_ID;
 		texture2d.m_ID = NULL;
 		m_mode = texture2d.m_mode;
 		m_width = texture2d.m_width;
 		m_height = texture2d.m_height;
+		m_layersCount = texture2d.m_layersCount;
+		m_pixels = std::move(texture2d.m_pixels);
 
 		return *this;
 	}
@@ -53,20 +98,25 @@ namespace Renderer {
 		m_mode = texture2d.m_mode;
 		m_width = texture2d.m_width;
 		m_height = texture2d.m_height;
+		m_layersCount = texture2d.m_layersCount;
+		m_pixels = std::move(texture2d.m_pixels);
 	}
 
 	Texture2D::~Texture2D(){
-		glDeleteTextures(1, &m_ID);
+		if (m_ID != 0) {
+			RenderBackend::current().deleteTexture(m_ID);
+			--RenderBackend::m_objectsCount;
+		}
 	}
 
-	void Texture2D::bind() const {
-		glBindTexture(GL_TEXTURE_2D, m_ID);
+	void Texture2D::bind(const GLuint unit) const {
+		RenderBackend::current().bindTexture(unit, m_ID);
 	}
 
 
-	void Texture2D::addSubTexture(std::string name, const glm::vec2& leftBottomUV, const glm::vec2& rightTopUV) 
+	void Texture2D::addSubTexture(std::string name, const glm::vec2& leftBottomUV, const glm::vec2& rightTopUV, const unsigned int layer) 
 	{
-		m_subTextures.emplace(std::move(name), SubTexture2D(leftBottomUV, rightTopUV));
+		m_subTextures.emplace(std::move(name), SubTexture2D(leftBottomUV, rightTopUV, layer));
 	}
 	const Texture2D::SubTexture2D& Texture2D::getSubTexture(const std::string& name) const
 	{
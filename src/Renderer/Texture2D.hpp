@@ -2,24 +2,32 @@
 
 #include <glad/glad.h>
 #include <glm/vec2.hpp>
+#include <cstdint>
 #include <string>
 #include <map>
+#include <vector>
 
 namespace Renderer {
+	// Always a GL_TEXTURE_2D_ARRAY: a plain texture is a single layer, atlas
+	// pages of different sheets share one object so sprites from any of them
+	// can be drawn in the same batch.
 	class Texture2D {
 	public:
 		struct SubTexture2D {
 			glm::vec2 leftBottomUV;
 			glm::vec2 rightTopUV;
+			unsigned int layer;
 
-			SubTexture2D(const glm::vec2& _leftBottomUV, const glm::vec2& _rightTopUV) :
+			SubTexture2D(const glm::vec2& _leftBottomUV, const glm::vec2& _rightTopUV, const unsigned int _layer = 0) :
 				leftBottomUV(_leftBottomUV),
-				rightTopUV(_rightTopUV)
+				rightTopUV(_rightTopUV),
+				layer(_layer)
 			{}
 
 			SubTexture2D() :
 				leftBottomUV(0.f),
-				rightTopUV(1.f)
+				rightTopUV(1.f),
+				layer(0)
 			{}
 		};
 
@@ -30,6 +38,13 @@ namespace Renderer {
 				  const GLuint filter = GL_LINEAR, 
 				  const GLenum wrapMode = GL_CLAMP_TO_EDGE
 		);
+		// every layer is width x height RGBA
+		Texture2D(const GLuint width,
+				  const GLuint height,
+				  const std::vector<const unsigned char*>& layersData,
+				  const GLuint filter = GL_LINEAR,
+				  const GLenum wrapMode = GL_CLAMP_TO_EDGE
+		);
 
 		Texture2D() = delete;
 		Texture2D(const Texture2D&) = delete;
@@ -39,19 +54,28 @@ namespace Renderer {
 
 		~Texture2D();
 
-		void addSubTexture(std::string name, const glm::vec2& leftBottomUV, const glm::vec2& rightTopUV);
+		void addSubTexture(std::string name, const glm::vec2& leftBottomUV, const glm::vec2& rightTopUV, const unsigned int layer = 0);
 		const SubTexture2D& getSubTexture(const std::string& name) const;
 
+		GLuint id() const { return m_ID; }
 		unsigned int width() const { return m_width; }
 		unsigned int height() const { return m_height; }
+		unsigned int layersCount() const { return m_layersCount; }
+		// CPU copy for the software renderer: RGBA, bottom row first; nullptr
+		// unless the backend the texture was created with needs it
+		const uint32_t* pixels(const unsigned int layer) const { return m_pixels.empty() ? nullptr : m_pixels.data() + static_cast<size_t>(layer) * m_width * m_height; }
 
-		void bind() const;
+		void bind(const GLuint unit = 0) const;
 	private:
+		void create(const std::vector<const unsigned char*>& layersData, const GLuint filter, const GLenum wrapMode);
+
 		GLuint m_ID;
 		GLenum m_mode;
 		unsigned int m_width;
 		unsigned int m_height;
+		unsigned int m_layersCount;
 
+		std::vector<uint32_t> m_pixels;
 		std::map<std::string, SubTexture2D> m_subTextures;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,345 @@
+#include "TileMapRenderer.hpp"
+
+#include "GLStateCache.hpp"
+#include "RenderQueue.hpp"
+#include "AnimationClipTable.hpp"
+#include "RenderStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+namespace Renderer {
+
+	TileMapRenderer::TileMapRenderer(std::shared_ptr<Texture2D> pTexture,
+									 std::shared_ptr<ShaderProgram> pShaderProgram,
+									 const unsigned int width,
+									 const unsigned int height,
+									 const float tileSize,
+									 const glm::vec2& position,
+									 const unsigned int layersCount,
+									 const unsigned int chunkSize) :
+		m_pTexture(std::move(pTexture)),
+		m_pShaderProgram(std::move(pShaderProgram)),
+		m_width(width),
+		m_height(height),
+		m_tileSize(tileSize),
+		m_position(position),
+		m_chunkSize(chunkSize),
+		m_chunksCountX((width + chunkSize - 1) / chunkSize),
+		m_chunksCountY((height + chunkSize - 1) / chunkSize),
+		m_layers(layersCount)
+	{
+		const size_t chunkTiles = static_cast<size_t>(m_chunkSize) * m_chunkSize;
+		const size_t chunksCount = static_cast<size_t>(m_chunksCountX) * m_chunksCountY;
+		m_chunkVertices.resize(4 * chunkTiles);
+
+		for (Layer& layer : m_layers)
+		{
+			layer.tiles.resize(static_cast<size_t>(m_width) * m_height);
+			layer.dirtyChunks.assign(chunksCount, true);
+		}
+	}
+
+	TileMapRenderer::~TileMapRenderer()
+	{
+		if (m_EBO == 0)
+		{
+			return;
+		}
+
+		for (Layer& layer : m_layers)
+		{
+			GLStateCache::deleteBuffer(layer.VBO);
+			GLStateCache::deleteVertexArray(layer.VAO);
+		}
+		GLStateCache::deleteBuffer(m_EBO);
+	}
+
+	void TileMapRenderer::createBuffers()
+	{
+		const size_t chunkTiles = static_cast<size_t>(m_chunkSize) * m_chunkSize;
+		const size_t chunksCount = static_cast<size_t>(m_chunksCountX) * m_chunksCountY;
+		const size_t slotsCount = chunksCount * chunkTiles;
+
+		// 1--2
+		// | /|
+		// |/ |
+		// 0--3
+		std::vector<GLuint> indices(6 * slotsCount);
+		for (size_t i = 0; i < slotsCount; ++i)
+		{
+			const GLuint firstVertex = static_cast<GLuint>(4 * i);
+			indices[6 * i + 0] = firstVertex + 0;
+			indices[6 * i + 1] = firstVertex + 1;
+			indices[6 * i + 2] = firstVertex + 2;
+
+			indices[6 * i + 3] = firstVertex + 2;
+			indices[6 * i + 4] = firstVertex + 3;
+			indices[6 * i + 5] = firstVertex + 0;
+		}
+
+		glGenBuffers(1, &m_EBO);
+		for (Layer& layer : m_layers)
+		{
+			glGenVertexArrays(1, &layer.VAO);
+			GLStateCache::bindVertexArray(layer.VAO);
+
+			glGenBuffers(1, &layer.VBO);
+			GLStateCache::bindBuffer(GL_ARRAY_BUFFER, layer.VBO);
+			glBufferData(GL_ARRAY_BUFFER, 4 * slotsCount * sizeof(Vertex), nullptr, GL_STATIC_DRAW);
+
+			glEnableVertexAttribArray(0);
+			glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, position)));
+			glEnableVertexAttribArray(1);
+			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, textureCoords)));
+			glEnableVertexAttribArray(2);
+			glVertexAttribIPointer(2, 1, GL_INT, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, clipID)));
+			glEnableVertexAttribArray(3);
+			glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, startTime)));
+
+			GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+			if (&layer == &m_layers.front())
+			{
+				glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+			}
+		}
+
+		GLStateCache::bindVertexArray(0);
+		GLStateCache::bindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	size_t TileMapRenderer::chunkIndex(const unsigned int x, const unsigned int y) const
+	{
+		return static_cast<size_t>(y / m_chunkSize) * m_chunksCountX + x / m_chunkSize;
+	}
+
+	void TileMapRenderer::markDirty(Layer& layer, const unsigned int x, const unsigned int y)
+	{
+		layer.dirtyChunks[chunkIndex(x, y)] = true;
+		layer.isDirty = true;
+	}
+
+	TileMapRenderer::Tile* TileMapRenderer::findTile(const unsigned int layer, const unsigned int x, const unsigned int y)
+	{
+		if (layer >= m_layers.size() || x >= m_width || y >= m_height)
+		{
+			std::cerr << "Tile out of the map: " << x << ", " << y << " on layer " << layer << std::endl;
+			return nullptr;
+		}
+		return &m_layers[layer].tiles[static_cast<size_t>(y) * m_width + x];
+	}
+
+	void TileMapRenderer::setTile(const unsigned int layer, const unsigned int x, const unsigned int y, const Texture2D::SubTexture2D& subTexture)
+	{
+		Tile* pTile = findTile(layer, x, y);
+		if (!pTile)
+		{
+			return;
+		}
+
+		pTile->subTexture = subTexture;
+		pTile->clipID = -1;
+		pTile->isEmpty = false;
+		markDirty(m_layers[layer], x, y);
+	}
+
+	void TileMapRenderer::setAnimatedTile(const unsigned int layer, const unsigned int x, const unsigned int y, const int clipID, const float startTime)
+	{
+		Tile* pTile = findTile(layer, x, y);
+		if (!pTile)
+		{
+			return;
+		}
+
+		pTile->clipID = clipID;
+		pTile->startTime = startTime;
+		pTile->isEmpty = false;
+		markDirty(m_layers[layer], x, y);
+	}
+
+	void TileMapRenderer::clearTile(const unsigned int layer, const unsigned int x, const unsigned int y)
+	{
+		Tile* pTile = findTile(layer, x, y);
+		if (pTile && !pTile->isEmpty)
+		{
+			pTile->isEmpty = true;
+			markDirty(m_layers[layer], x, y);
+		}
+	}
+
+	void TileMapRenderer::rebuildChunk(Layer& layer, const size_t chunk)
+	{
+		const unsigned int firstX = static_cast<unsigned int>(chunk % m_chunksCountX) * m_chunkSize;
+		const unsigned int firstY = static_cast<unsigned int>(chunk / m_chunksCountX) * m_chunkSize;
+
+		size_t vertex = 0;
+		for (unsigned int localY = 0; localY < m_chunkSize; ++localY)
+		{
+			for (unsigned int localX = 0; localX < m_chunkSize; ++localX)
+			{
+				const unsigned int x = firstX + localX;
+				const unsigned int y = firstY + localY;
+				if (x >= m_width || y >= m_height || layer.tiles[static_cast<size_t>(y) * m_width + x].isEmpty)
+				{
+					for (size_t i = 0; i < 4; ++i)
+					{
+						m_chunkVertices[vertex++] = Vertex{ glm::vec2(0.f), glm::vec3(0.f), -1, 0.f };
+					}
+					continue;
+				}
+
+				const Tile& tile = layer.tiles[static_cast<size_t>(y) * m_width + x];
+				// row 0 is the top of the map
+				const glm::vec2 leftBottom = m_position + m_tileSize * glm::vec2(x, m_height - 1 - y);
+				const glm::vec2 rightTop = leftBottom + glm::vec2(m_tileSize);
+
+				// animated tiles keep the unit quad corner, remapped to the frame in the shader
+				const glm::vec2 leftBottomUV = tile.clipID < 0 ? tile.subTexture.leftBottomUV : glm::vec2(0.f);
+				const glm::vec2 rightTopUV = tile.clipID < 0 ? tile.subTexture.rightTopUV : glm::vec2(1.f);
+
+				const float textureLayer = static_cast<float>(tile.subTexture.layer);
+
+				m_chunkVertices[vertex++] = Vertex{ leftBottom, glm::vec3(leftBottomUV, textureLayer), tile.clipID, tile.startTime };
+				m_chunkVertices[vertex++] = Vertex{ glm::vec2(leftBottom.x, rightTop.y), glm::vec3(leftBottomUV.x, rightTopUV.y, textureLayer), tile.clipID, tile.startTime };
+				m_chunkVertices[vertex++] = Vertex{ rightTop, glm::vec3(rightTopUV, textureLayer), tile.clipID, tile.startTime };
+				m_chunkVertices[vertex++] = Vertex{ glm::vec2(rightTop.x, leftBottom.y), glm::vec3(rightTopUV.x, leftBottomUV.y, textureLayer), tile.clipID, tile.startTime };
+			}
+		}
+
+		GLStateCache::bindBuffer(GL_ARRAY_BUFFER, layer.VBO);
+		glBufferSubData(GL_ARRAY_BUFFER, chunk * m_chunkVertices.size() * sizeof(Vertex), m_chunkVertices.size() * sizeof(Vertex), m_chunkVertices.data());
+		RenderStats::addUpload(m_chunkVertices.size() * sizeof(Vertex));
+		++m_rebuiltChunksCount;
+	}
+
+	bool TileMapRenderer::visibleTiles(const ViewRect& view, unsigned int& firstX, unsigned int& firstY, unsigned int& lastX, unsigned int& lastY) const
+	{
+		// in tiles from the bottom-left corner of the map
+		const glm::vec2 min = glm::floor((view.min - m_position) / m_tileSize);
+		const glm::vec2 max = glm::ceil((view.max - m_position) / m_tileSize) - 1.f;
+		if (max.x < 0.f || max.y < 0.f || min.x >= static_cast<float>(m_width) || min.y >= static_cast<float>(m_height) || min.x > max.x || min.y > max.y)
+		{
+			return false;
+		}
+
+		firstX = static_cast<unsigned int>(std::max(min.x, 0.f));
+		lastX = static_cast<unsigned int>(std::min(max.x, static_cast<float>(m_width - 1)));
+		// row 0 is the top of the map
+		firstY = m_height - 1 - static_cast<unsigned int>(std::min(max.y, static_cast<float>(m_height - 1)));
+		lastY = m_height - 1 - static_cast<unsigned int>(std::max(min.y, 0.f));
+		return true;
+	}
+
+	void TileMapRenderer::render(const unsigned int layerIndex)
+	{
+		render(layerIndex, ViewRect{ m_position, m_position + m_tileSize * glm::vec2(m_width, m_height) });
+	}
+
+	void TileMapRenderer::render(const unsigned int layerIndex, const ViewRect& view)
+	{
+		m_drawnChunksCount = 0;
+		if (layerIndex >= m_layers.size())
+		{
+			return;
+		}
+
+		if (m_EBO == 0)
+		{
+			createBuffers();
+		}
+
+		Layer& layer = m_layers[layerIndex];
+		if (layer.isDirty)
+		{
+			for (size_t chunk = 0; chunk < layer.dirtyChunks.size(); ++chunk)
+			{
+				if (layer.dirtyChunks[chunk])
+				{
+					rebuildChunk(layer, chunk);
+					layer.dirtyChunks[chunk] = false;
+				}
+			}
+			layer.isDirty = false;
+		}
+
+		unsigned int firstX, firstY, lastX, lastY;
+		if (!visibleTiles(view, firstX, firstY, lastX, lastY))
+		{
+			return;
+		}
+
+		m_pShaderProgram->use();
+		m_pTexture->bind(0);
+		GLStateCache::bindVertexArray(layer.VAO);
+
+		const size_t chunkIndicesCount = 6 * static_cast<size_t>(m_chunkSize) * m_chunkSize;
+		auto drawChunks = [this, chunkIndicesCount](const size_t firstChunk, const size_t chunksCount) {
+			const size_t indicesCount = chunksCount * chunkIndicesCount;
+			glDrawElements(GL_TRIANGLES,
+						   static_cast<GLsizei>(indicesCount),
+						   GL_UNSIGNED_INT,
+						   reinterpret_cast<const void*>(firstChunk * chunkIndicesCount * sizeof(GLuint)));
+			RenderStats::addDraw(indicesCount);
+			m_drawnChunksCount += chunksCount;
+		};
+
+		// rows spanning the whole map width join into one range
+		const size_t firstChunkX = firstX / m_chunkSize;
+		const size_t rowChunksCount = lastX / m_chunkSize - firstChunkX + 1;
+		size_t rangeFirst = 0;
+		size_t rangeCount = 0;
+		for (unsigned int chunkY = firstY / m_chunkSize; chunkY <= lastY / m_chunkSize; ++chunkY)
+		{
+			const size_t rowFirst = static_cast<size_t>(chunkY) * m_chunksCountX + firstChunkX;
+			if (rangeCount > 0 && rangeFirst + rangeCount == rowFirst)
+			{
+				rangeCount += rowChunksCount;
+				continue;
+			}
+			if (rangeCount > 0)
+			{
+				drawChunks(rangeFirst, rangeCount);
+			}
+			rangeFirst = rowFirst;
+			rangeCount = rowChunksCount;
+		}
+		drawChunks(rangeFirst, rangeCount);
+	}
+
+	void TileMapRenderer::submit(RenderQueue& renderQueue,
+								 const unsigned int layerIndex,
+								 const ERenderLayer renderLayer,
+								 const AnimationClipTable& animationClipTable,
+								 const float time,
+								 const ViewRect& view) const
+	{
+		unsigned int firstX, firstY, lastX, lastY;
+		if (layerIndex >= m_layers.size() || !visibleTiles(view, firstX, firstY, lastX, lastY))
+		{
+			return;
+		}
+
+		const Layer& layer = m_layers[layerIndex];
+		for (unsigned int y = firstY; y <= lastY; ++y)
+		{
+			for (unsigned int x = firstX; x <= lastX; ++x)
+			{
+				const Tile& tile = layer.tiles[static_cast<size_t>(y) * m_width + x];
+				if (tile.isEmpty)
+				{
+					continue;
+				}
+
+				// row 0 is the top of the map
+				const SpriteInstance instance{ m_position + m_tileSize * glm::vec2(x, m_height - 1 - y),
+											   glm::vec2(m_tileSize),
+											   0.f,
+											   tile.clipID < 0 ? tile.subTexture : animationClipTable.frame(tile.clipID, time - tile.startTime) };
+				renderQueue.submit(renderLayer, 0.f, *m_pShaderProgram, *m_pTexture, instance);
+			}
+		}
+	}
+
+}
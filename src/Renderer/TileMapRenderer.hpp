@@ -0,0 +1,112 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "Texture2D.hpp"
+#include "ShaderProgram.hpp"
+#include "Camera.hpp"
+
+namespace Renderer {
+
+	class RenderQueue;
+	class AnimationClipTable;
+	enum class ERenderLayer : uint8_t;
+
+	// Static tile geometry kept on the GPU. The map is split into square
+	// chunks; every chunk owns a fixed slot in the vertex buffer of each
+	// layer, so changing a tile re-uploads only its chunk and a whole layer
+	// is still drawn with one call. Empty tiles are degenerate quads.
+	// Animated tiles reference an AnimationClipTable clip and are advanced
+	// by the vertex shader (see vTile), never by rebuilding chunks.
+	// Given a view, only the chunks it overlaps are drawn: chunk slots are
+	// laid out row by row, so each visible chunk row is one contiguous range.
+	class TileMapRenderer {
+	public:
+		TileMapRenderer(std::shared_ptr<Texture2D> pTexture,
+						std::shared_ptr<ShaderProgram> pShaderProgram,
+						const unsigned int width,
+						const unsigned int height,
+						const float tileSize,
+						const glm::vec2& position = glm::vec2(0.f),
+						const unsigned int layersCount = 1,
+						const unsigned int chunkSize = 8);
+		~TileMapRenderer();
+
+		TileMapRenderer(const TileMapRenderer&) = delete;
+		TileMapRenderer& operator=(const TileMapRenderer&) = delete;
+
+		void setTile(const unsigned int layer, const unsigned int x, const unsigned int y, const Texture2D::SubTexture2D& subTexture);
+		void setAnimatedTile(const unsigned int layer, const unsigned int x, const unsigned int y, const int clipID, const float startTime = 0.f);
+		void clearTile(const unsigned int layer, const unsigned int x, const unsigned int y);
+
+		void render(const unsigned int layer);
+		void render(const unsigned int layer, const ViewRect& view);
+		// one command per tile in view, animated tiles resolved at time seconds; for renderers without the tile shader
+		void submit(RenderQueue& renderQueue,
+					const unsigned int layer,
+					const ERenderLayer renderLayer,
+					const AnimationClipTable& animationClipTable,
+					const float time,
+					const ViewRect& view) const;
+
+		unsigned int width() const { return m_width; }
+		unsigned int height() const { return m_height; }
+		// total since creation, compare between frames to see rebuilds
+		size_t rebuiltChunksCount() const { return m_rebuiltChunksCount; }
+		// by the last render
+		size_t drawnChunksCount() const { return m_drawnChunksCount; }
+
+	private:
+		struct Vertex {
+			glm::vec2 position;
+			glm::vec3 textureCoords;
+			GLint clipID;
+			GLfloat startTime;
+		};
+
+		struct Tile {
+			Texture2D::SubTexture2D subTexture;
+			int clipID = -1;
+			float startTime = 0.f;
+			bool isEmpty = true;
+		};
+
+		struct Layer {
+			std::vector<Tile> tiles;
+			std::vector<bool> dirtyChunks;
+			bool isDirty = true;
+			GLuint VAO = 0;
+			GLuint VBO = 0;
+		};
+
+		// GL objects are made on the first render, submit works without a context
+		void createBuffers();
+		Tile* findTile(const unsigned int layer, const unsigned int x, const unsigned int y);
+		size_t chunkIndex(const unsigned int x, const unsigned int y) const;
+		void markDirty(Layer& layer, const unsigned int x, const unsigned int y);
+		void rebuildChunk(Layer& layer, const size_t chunk);
+		// inclusive tile range overlapping view, false if there is none
+		bool visibleTiles(const ViewRect& view, unsigned int& firstX, unsigned int& firstY, unsigned int& lastX, unsigned int& lastY) const;
+
+		std::shared_ptr<Texture2D> m_pTexture;
+		std::shared_ptr<ShaderProgram> m_pShaderProgram;
+		unsigned int m_width;
+		unsigned int m_height;
+		float m_tileSize;
+		glm::vec2 m_position;
+		unsigned int m_chunkSize;
+		unsigned int m_chunksCountX;
+		unsigned int m_chunksCountY;
+		std::vector<Layer> m_layers;
+		std::vector<Vertex> m_chunkVertices;
+		GLuint m_EBO = 0;
+		size_t m_rebuiltChunksCount = 0;
+		size_t m_drawnChunksCount = 0;
+	};
+
+}
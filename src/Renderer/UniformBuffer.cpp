@@ -0,0 +1,38 @@
+#include "UniformBuffer.hpp"
+#include "GLStateCache.hpp"
+#include "RenderStats.hpp"
+
+#include <iostream>
+
+namespace Renderer {
+
+	UniformBuffer::UniformBuffer(const GLsizeiptr size, const GLuint bindingPoint) :
+		m_size(size),
+		m_bindingPoint(bindingPoint)
+	{
+		glGenBuffers(1, &m_ID);
+		GLStateCache::bindBuffer(GL_UNIFORM_BUFFER, m_ID);
+		glBufferData(GL_UNIFORM_BUFFER, m_size, nullptr, GL_DYNAMIC_DRAW);
+
+		GLStateCache::bindBufferBase(GL_UNIFORM_BUFFER, m_bindingPoint, m_ID);
+	}
+
+	UniformBuffer::~UniformBuffer()
+	{
+		GLStateCache::deleteBuffer(m_ID);
+	}
+
+	void UniformBuffer::update(const void* data, const GLsizeiptr size, const GLintptr offset)
+	{
+		if (offset + size > m_size)
+		{
+			std::cerr << "Uniform buffer update out of range: " << offset + size << " > " << m_size << std::endl;
+			return;
+		}
+
+		GLStateCache::bindBuffer(GL_UNIFORM_BUFFER, m_ID);
+		glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+		RenderStats::addUpload(static_cast<size_t>(size));
+	}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <glad/glad.h>
+
+namespace Renderer {
+
+	// std140 uniform block storage attached to a fixed binding point.
+	// Programs see it through ShaderProgram::setUniformBlockBinding.
+	class UniformBuffer {
+	public:
+		UniformBuffer(const GLsizeiptr size, const GLuint bindingPoint);
+		~UniformBuffer();
+
+		UniformBuffer() = delete;
+		UniformBuffer(const UniformBuffer&) = delete;
+		UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+		void update(const void* data, const GLsizeiptr size, const GLintptr offset = 0);
+
+		GLuint bindingPoint() const { return m_bindingPoint; }
+
+	private:
+		GLuint m_ID = 0;
+		GLsizeiptr m_size;
+		GLuint m_bindingPoint;
+	};
+
+}
@@ -0,0 +1,124 @@
+#include "VisibilityGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Renderer {
+
+	VisibilityGrid::VisibilityGrid(const ViewRect& bounds, const float cellSize) :
+		m_origin(bounds.min),
+		m_cellSize(cellSize),
+		m_cellsCountX(std::max(1u, static_cast<unsigned int>(std::ceil((bounds.max.x - bounds.min.x) / cellSize)))),
+		m_cellsCountY(std::max(1u, static_cast<unsigned int>(std::ceil((bounds.max.y - bounds.min.y) / cellSize)))),
+		m_cells(static_cast<size_t>(m_cellsCountX) * m_cellsCountY)
+	{
+	}
+
+	unsigned int VisibilityGrid::cellX(const float x) const
+	{
+		const float cell = std::floor((x - m_origin.x) / m_cellSize);
+		return static_cast<unsigned int>(std::clamp(cell, 0.f, static_cast<float>(m_cellsCountX - 1)));
+	}
+
+	unsigned int VisibilityGrid::cellY(const float y) const
+	{
+		const float cell = std::floor((y - m_origin.y) / m_cellSize);
+		return static_cast<unsigned int>(std::clamp(cell, 0.f, static_cast<float>(m_cellsCountY - 1)));
+	}
+
+	void VisibilityGrid::addToCell(const uint32_t id, Object& object)
+	{
+		object.cell = cellY(object.position.y) * m_cellsCountX + cellX(object.position.x);
+		std::vector<uint32_t>& cell = m_cells[object.cell];
+		object.slot = static_cast<uint32_t>(cell.size());
+		cell.push_back(id);
+	}
+
+	void VisibilityGrid::removeFromCell(const Object& object)
+	{
+		// swap and pop, the moved id takes over the slot
+		std::vector<uint32_t>& cell = m_cells[object.cell];
+		const uint32_t lastID = cell.back();
+		cell[object.slot] = lastID;
+		m_objects[lastID].slot = object.slot;
+		cell.pop_back();
+	}
+
+	void VisibilityGrid::insert(const uint32_t id, const glm::vec2& position, const glm::vec2& size)
+	{
+		if (id >= m_objects.size())
+		{
+			m_objects.resize(static_cast<size_t>(id) + 1);
+		}
+
+		Object& object = m_objects[id];
+		if (object.isInserted)
+		{
+			removeFromCell(object);
+		}
+		else
+		{
+			object.isInserted = true;
+			++m_objectsCount;
+		}
+
+		object.position = position;
+		object.size = size;
+		m_maxObjectSize = glm::max(m_maxObjectSize, size);
+		addToCell(id, object);
+	}
+
+	void VisibilityGrid::move(const uint32_t id, const glm::vec2& position)
+	{
+		if (id >= m_objects.size() || !m_objects[id].isInserted)
+		{
+			return;
+		}
+
+		Object& object = m_objects[id];
+		const uint32_t cell = cellY(position.y) * m_cellsCountX + cellX(position.x);
+		object.position = position;
+		if (cell != object.cell)
+		{
+			removeFromCell(object);
+			addToCell(id, object);
+		}
+	}
+
+	void VisibilityGrid::remove(const uint32_t id)
+	{
+		if (id >= m_objects.size() || !m_objects[id].isInserted)
+		{
+			return;
+		}
+
+		Object& object = m_objects[id];
+		removeFromCell(object);
+		object.isInserted = false;
+		--m_objectsCount;
+	}
+
+	void VisibilityGrid::query(const ViewRect& view, std::vector<uint32_t>& ids) const
+	{
+		const unsigned int firstX = cellX(view.min.x - m_maxObjectSize.x);
+		const unsigned int firstY = cellY(view.min.y - m_maxObjectSize.y);
+		const unsigned int lastX = cellX(view.max.x);
+		const unsigned int lastY = cellY(view.max.y);
+
+		for (unsigned int y = firstY; y <= lastY; ++y)
+		{
+			for (unsigned int x = firstX; x <= lastX; ++x)
+			{
+				for (const uint32_t id : m_cells[static_cast<size_t>(y) * m_cellsCountX + x])
+				{
+					const Object& object = m_objects[id];
+					if (view.overlaps(object.position, object.size))
+					{
+						ids.push_back(id);
+					}
+				}
+			}
+		}
+	}
+
+}
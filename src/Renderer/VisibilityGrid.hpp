@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Camera.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Renderer {
+
+	// Uniform grid over the world answering which objects overlap a view.
+	// Each object is kept in the cell holding its bottom-left corner and a
+	// query widens the view by the largest object size, so objects reaching
+	// into the view from a neighbouring cell are still found. Objects are
+	// identified by ids the caller chooses, typically indices of its own
+	// array. Positions outside the grid go to the nearest edge cell.
+	class VisibilityGrid {
+	public:
+		VisibilityGrid(const ViewRect& bounds, const float cellSize);
+
+		void insert(const uint32_t id, const glm::vec2& position, const glm::vec2& size);
+		void move(const uint32_t id, const glm::vec2& position);
+		void remove(const uint32_t id);
+
+		// appends the ids of the objects overlapping view, in no particular order
+		void query(const ViewRect& view, std::vector<uint32_t>& ids) const;
+
+		size_t objectsCount() const { return m_objectsCount; }
+		size_t cellsCount() const { return m_cells.size(); }
+
+	private:
+		struct Object {
+			glm::vec2 position;
+			glm::vec2 size;
+			uint32_t cell = 0;
+			// index in the cell's ids
+			uint32_t slot = 0;
+			bool isInserted = false;
+		};
+
+		unsigned int cellX(const float x) const;
+		unsigned int cellY(const float y) const;
+		void addToCell(const uint32_t id, Object& object);
+		void removeFromCell(const Object& object);
+
+		glm::vec2 m_origin;
+		float m_cellSize;
+		unsigned int m_cellsCountX;
+		unsigned int m_cellsCountY;
+		std::vector<std::vector<uint32_t>> m_cells;
+		std::vector<Object> m_objects;
+		size_t m_objectsCount = 0;
+		glm::vec2 m_maxObjectSize = glm::vec2(0.f);
+	};
+
+}
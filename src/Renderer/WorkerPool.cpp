@@ -0,0 +1,83 @@
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+namespace Renderer {
+
+	WorkerPool::WorkerPool(const unsigned int threadsCount)
+	{
+		const unsigned int poolThreadsCount = (threadsCount ? threadsCount : std::max(1u, std::thread::hardware_concurrency())) - 1;
+		m_threads.reserve(poolThreadsCount);
+		for (unsigned int i = 0; i < poolThreadsCount; ++i)
+		{
+			m_threads.emplace_back(&WorkerPool::runWorker, this, i + 1);
+		}
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_isStopping = true;
+		}
+		m_startCondition.notify_all();
+		for (auto& thread : m_threads)
+		{
+			thread.join();
+		}
+	}
+
+	void WorkerPool::run(const unsigned int workersCount, const Task& task)
+	{
+		const unsigned int count = std::clamp(workersCount, 1u, threadsCount());
+		if (count == 1)
+		{
+			task(0);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_pTask = &task;
+			m_workersCount = count;
+			m_pendingCount = count - 1;
+			++m_generation;
+		}
+		m_startCondition.notify_all();
+
+		task(0);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_doneCondition.wait(lock, [this] { return m_pendingCount == 0; });
+		m_pTask = nullptr;
+	}
+
+	void WorkerPool::runWorker(const unsigned int workerIndex)
+	{
+		uint64_t generation = 0;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true)
+		{
+			m_startCondition.wait(lock, [this, generation] { return m_isStopping || m_generation != generation; });
+			if (m_isStopping)
+			{
+				return;
+			}
+			generation = m_generation;
+			if (workerIndex >= m_workersCount)
+			{
+				continue;
+			}
+
+			const Task& task = *m_pTask;
+			lock.unlock();
+			task(workerIndex);
+			lock.lock();
+			if (--m_pendingCount == 0)
+			{
+				m_doneCondition.notify_one();
+			}
+		}
+	}
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Renderer {
+
+	// Threads kept alive for the lifetime of their owner and woken for each
+	// parallel job, so per-frame work doesn't pay for creating and joining
+	// threads. The calling thread always takes part as worker 0. run() is
+	// called from one thread at a time.
+	class WorkerPool {
+	public:
+		// runs on every worker taking part, workerIndex in [0, workersCount)
+		using Task = std::function<void(const unsigned int workerIndex)>;
+
+		// threadsCount includes the calling thread, 0 uses one per hardware thread
+		explicit WorkerPool(const unsigned int threadsCount);
+		~WorkerPool();
+
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		// workersCount is clamped to [1, threadsCount()]; returns once every worker has returned
+		void run(const unsigned int workersCount, const Task& task);
+
+		unsigned int threadsCount() const { return static_cast<unsigned int>(m_threads.size()) + 1; }
+
+	private:
+		void runWorker(const unsigned int workerIndex);
+
+		std::vector<std::thread> m_threads;
+		std::mutex m_mutex;
+		std::condition_variable m_startCondition;
+		std::condition_variable m_doneCondition;
+		const Task* m_pTask = nullptr;
+		unsigned int m_workersCount = 0;
+		// pool threads still running the current task
+		unsigned int m_pendingCount = 0;
+		// bumped by every run, wakes the pool threads
+		uint64_t m_generation = 0;
+		bool m_isStopping = false;
+	};
+
+}
@@ -3,7 +3,11 @@
 #include "../Renderer/Texture2D.hpp"
 #include "../Renderer/Sprite.hpp"
 #include "../Renderer/AnimatedSprite.hpp"
+#include "../Renderer/RenderBackend.hpp"
+#include "../Renderer/FrameData.hpp"
+#include "../Renderer/AnimationClipTable.hpp"
 
+#include <algorithm>
 #include <sstream>
 #include <fstream>
 #include <iostream>
@@ -28,6 +32,7 @@ void ResourceManager::unloadAllResources() {
 	m_textures.clear();
 	m_sprites.clear();
 	m_animatedSprites.clear();
+	Renderer::RenderBackend::current().releaseResources();
 	m_path.clear();
 }
 
@@ -64,6 +69,8 @@ std::shared_ptr<Renderer::ShaderProgram> ResourceManager::loadShaders(
 	std::shared_ptr<Renderer::ShaderProgram>& newShader = m_shaderPrograms.emplace(shaderName, 
 	std::make_shared<Renderer::ShaderProgram>(vertexString, 																									fragmentString)).first->second;
 	if (newShader->isCompiled()) {
+		newShader->setUniformBlockBinding(Renderer::FrameData::BLOCK_NAME, Renderer::FrameData::BINDING_POINT);
+		newShader->setUniformBlockBinding(Renderer::AnimationClipTable::BLOCK_NAME, Renderer::AnimationClipTable::BINDING_POINT);
 		return newShader;
 	}
 	
@@ -139,7 +146,7 @@ std::shared_ptr<Renderer::Sprite> ResourceManager::loadSprite(const std::string&
 		return nullptr;
 	}
 
-	std::shared_ptr<Renderer::Sprite> newSprite = m_sprites.emplace(textureName,
+	std::shared_ptr<Renderer::Sprite> newSprite = m_sprites.emplace(spriteName,
 																	std::make_shared<Renderer::Sprite>(pTexture,
 																									   subTextureName,
 																									   pShader,
@@ -170,33 +177,111 @@ std::shared_ptr<Renderer::Texture2D> ResourceManager::loadTextureAtlas(std::stri
 	auto pTexture = loadTexture(std::move(textureName), std::move(texturePath));
 	if (pTexture)
 	{
-		const unsigned int textureWidth = pTexture->width();
-		const unsigned int textureHeight = pTexture->height();
-
-		unsigned int currentTextureOffsetX = 0;
-		unsigned int currentTextureOffsetY = textureHeight;
+		addAtlasSubTextures(*pTexture, subTextures, subTextureWidth, subTextureHeight, pTexture->width(), pTexture->height(), 0);
+	}
+	return pTexture;
+}
 
-		for (const auto& currentSubTextureName : subTextures)
-		{
-			glm::vec2 leftBottomUV(	static_cast<float>(currentTextureOffsetX) / textureWidth, 
-									static_cast<float>(currentTextureOffsetY - subTextureHeight) / textureHeight);
-			
-			glm::vec2 rightTopUV(	static_cast<float>(currentTextureOffsetX + subTextureWidth) / textureWidth, 
-									static_cast<float>(currentTextureOffsetY) / textureHeight);
+std::shared_ptr<Renderer::Texture2D> ResourceManager::loadTextureAtlasArray(const std::string textureName,
+																			const std::vector<TextureAtlasPage>& pages)
+{
+	struct Image {
+		unsigned char* pixels;
+		int width;
+		int height;
+	};
 
-			pTexture->addSubTexture(std::move(currentSubTextureName), leftBottomUV, rightTopUV);
+	std::vector<Image> images;
+	unsigned int textureWidth = 0;
+	unsigned int textureHeight = 0;
 
-			currentTextureOffsetX += subTextureWidth;
-			if (currentTextureOffsetX >= textureWidth) 
+	stbi_set_flip_vertically_on_load(true);
+	for (const auto& page : pages)
+	{
+		int channels = 0;
+		Image image{};
+		image.pixels = stbi_load(std::string(m_path + "/" + page.texturePath).c_str(), &image.width, &image.height, &channels, 4);
+		if (!image.pixels) {
+			std::cerr << "Can't load image: " << page.texturePath << std::endl;
+			for (const auto& loadedImage : images)
 			{
-				currentTextureOffsetY -= subTextureHeight;
-				currentTextureOffsetX = 0;
+				stbi_image_free(loadedImage.pixels);
 			}
+			return nullptr;
 		}
+		textureWidth = std::max(textureWidth, static_cast<unsigned int>(image.width));
+		textureHeight = std::max(textureHeight, static_cast<unsigned int>(image.height));
+		images.push_back(image);
+	}
+
+	// smaller pages sit in the bottom left corner of their layer (images are flipped on load)
+	std::vector<std::vector<unsigned char>> layers(images.size(), std::vector<unsigned char>(4 * textureWidth * textureHeight, 0));
+	std::vector<const unsigned char*> layersData;
+	for (size_t layer = 0; layer < images.size(); ++layer)
+	{
+		const Image& image = images[layer];
+		for (int row = 0; row < image.height; ++row)
+		{
+			std::copy_n(image.pixels + 4 * row * image.width, 4 * image.width, layers[layer].data() + 4 * row * textureWidth);
+		}
+		stbi_image_free(image.pixels);
+		layersData.push_back(layers[layer].data());
+	}
+
+	std::shared_ptr<Renderer::Texture2D> pTexture = m_textures.emplace(textureName,
+																	   std::make_shared<Renderer::Texture2D>(textureWidth,
+																											 textureHeight,
+																											 layersData,
+																											 GL_NEAREST,
+																											 GL_CLAMP_TO_EDGE)).first->second;
+
+	for (size_t layer = 0; layer < pages.size(); ++layer)
+	{
+		const TextureAtlasPage& page = pages[layer];
+		addAtlasSubTextures(*pTexture,
+							page.subTextures,
+							page.subTextureWidth,
+							page.subTextureHeight,
+							images[layer].width,
+							images[layer].height,
+							static_cast<unsigned int>(layer));
 	}
 	return pTexture;
 }
 
+void ResourceManager::addAtlasSubTextures(Renderer::Texture2D& texture,
+										  const std::vector<std::string>& subTextures,
+										  const unsigned int subTextureWidth,
+										  const unsigned int subTextureHeight,
+										  const unsigned int pageWidth,
+										  const unsigned int pageHeight,
+										  const unsigned int layer)
+{
+	const unsigned int textureWidth = texture.width();
+	const unsigned int textureHeight = texture.height();
+
+	unsigned int currentTextureOffsetX = 0;
+	unsigned int currentTextureOffsetY = pageHeight;
+
+	for (const auto& currentSubTextureName : subTextures)
+	{
+		glm::vec2 leftBottomUV(	static_cast<float>(currentTextureOffsetX) / textureWidth, 
+								static_cast<float>(currentTextureOffsetY - subTextureHeight) / textureHeight);
+		
+		glm::vec2 rightTopUV(	static_cast<float>(currentTextureOffsetX + subTextureWidth) / textureWidth, 
+								static_cast<float>(currentTextureOffsetY) / textureHeight);
+
+		texture.addSubTexture(currentSubTextureName, leftBottomUV, rightTopUV, layer);
+
+		currentTextureOffsetX += subTextureWidth;
+		if (currentTextureOffsetX >= pageWidth) 
+		{
+			currentTextureOffsetY -= subTextureHeight;
+			currentTextureOffsetX = 0;
+		}
+	}
+}
+
 std::shared_ptr<Renderer::AnimatedSprite> ResourceManager::loadAnimatedSprite(const std::string& spriteName,
 																			  const std::string& textureName,
 																			  const std::string& shaderName,
@@ -14,9 +14,18 @@ namespace Renderer {
 
 class ResourceManager {
 public:
+	struct TextureAtlasPage {
+		std::string texturePath;
+		std::vector<std::string> subTextures;
+		unsigned int subTextureWidth;
+		unsigned int subTextureHeight;
+	};
+
 	ResourceManager(const std::string executablePath);
 	
 	static void setExecutablePath(const std::string executablePath);
+	// the directory res/ is looked up in
+	static const std::string& getExecutableDirectory() { return m_path; }
 	static void unloadAllResources();
 	
 	ResourceManager() = delete;
@@ -54,9 +63,19 @@ public:
 																 const std::vector<std::string> subTextures,
 																 const unsigned int subTextureWidth,
 																 const unsigned int subTextureHeight);
+	// pages become layers of one texture array, padded to the largest page
+	static std::shared_ptr<Renderer::Texture2D> loadTextureAtlasArray(const std::string textureName,
+																	  const std::vector<TextureAtlasPage>& pages);
 
 private:
 	static std::string getFileString(const std::string& relativeFilePath);
+	static void addAtlasSubTextures(Renderer::Texture2D& texture,
+									const std::vector<std::string>& subTextures,
+									const unsigned int subTextureWidth,
+									const unsigned int subTextureHeight,
+									const unsigned int pageWidth,
+									const unsigned int pageHeight,
+									const unsigned int layer);
 
 	typedef std::map<const std::string, std::shared_ptr<Renderer::ShaderProgram>> ShaderProgramsMap;
 	static ShaderProgramsMap m_shaderPrograms;
@@ -0,0 +1,163 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../Renderer/GLTracePlayer.hpp"
+#ifdef BATTLECITY_HEADLESS
+#include "../Renderer/HeadlessContext.hpp"
+#endif
+
+// Replays a GL trace recorded with `BattleCity --record <path>` in a loop
+// and times it, without the game, its input or asset loading. --dump saves
+// the native image of the last frame, to compare with `BattleCity --dump`.
+//   BattleCityReplayGL <trace> [--loops N] [--headless] [--dump <path>]
+
+namespace {
+	bool hasArgument(int argc, char** argv, const std::string& argument) {
+		for (int i = 1; i < argc; ++i) {
+			if (argument == argv[i]) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	const char* getArgumentValue(int argc, char** argv, const std::string& argument, const char* defaultValue) {
+		for (int i = 1; i + 1 < argc; ++i) {
+			if (argument == argv[i]) {
+				return argv[i + 1];
+			}
+		}
+		return defaultValue;
+	}
+
+	// binary PPM, top row first; pixels are RGBA rows, bottom row first
+	bool saveImage(const std::string& path, const std::vector<unsigned char>& pixels, const GLsizei width, const GLsizei height) {
+		std::ofstream file(path, std::ios::binary);
+		if (!file.is_open()) {
+			std::cerr << "Can't write image: " << path << std::endl;
+			return false;
+		}
+
+		file << "P6\n" << width << " " << height << "\n255\n";
+		for (GLsizei row = height; row-- > 0;) {
+			for (GLsizei column = 0; column < width; ++column) {
+				file.write(reinterpret_cast<const char*>(&pixels[4 * (static_cast<size_t>(row) * width + column)]), 3);
+			}
+		}
+		return true;
+	}
+
+	int replay(Renderer::GLTracePlayer& player, const unsigned int loopsCount, const char* dumpPath) {
+		std::cout << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
+		std::cout << "Trace: " << player.commandsCount() << " commands, " << player.dataSize() << " bytes of data, "
+				  << player.framesCount() << " frames" << std::endl;
+
+		player.playSetup();
+		glFinish();
+
+		double totalCpuTime = 0.0;
+		double totalWallTime = 0.0;
+		double minWallTime = 0.0;
+		double maxWallTime = 0.0;
+		for (unsigned int loop = 0; loop < loopsCount; ++loop) {
+			const auto startTime = std::chrono::high_resolution_clock::now();
+			player.playFrames();
+			const auto submitTime = std::chrono::high_resolution_clock::now();
+			glFinish();
+			const auto endTime = std::chrono::high_resolution_clock::now();
+
+			const double wallTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+			totalCpuTime += std::chrono::duration<double, std::milli>(submitTime - startTime).count();
+			totalWallTime += wallTime;
+			minWallTime = loop == 0 ? wallTime : std::min(minWallTime, wallTime);
+			maxWallTime = std::max(maxWallTime, wallTime);
+		}
+
+		const double framesCount = static_cast<double>(player.framesCount()) * loopsCount;
+		std::cout << "Replayed " << loopsCount << " loops: per frame CPU submit " << totalCpuTime / framesCount << " ms, "
+				  << "wall with GPU " << totalWallTime / framesCount << " ms; "
+				  << "per loop min " << minWallTime << " ms, max " << maxWallTime << " ms" << std::endl;
+
+		if (dumpPath) {
+			std::vector<unsigned char> pixels;
+			GLsizei width = 0;
+			GLsizei height = 0;
+			if (!player.readBlitSource(pixels, width, height)) {
+				std::cout << "The trace has no blit to read the native image from" << std::endl;
+			}
+			else if (saveImage(dumpPath, pixels, width, height)) {
+				std::cout << "Saved the last frame to " << dumpPath << std::endl;
+			}
+		}
+
+		const GLenum error = glGetError();
+		if (error != GL_NO_ERROR) {
+			std::cout << "GL error after replay: 0x" << std::hex << error << std::dec << std::endl;
+		}
+		return 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2 || argv[1][0] == '-') {
+		std::cout << "Usage: BattleCityReplayGL <trace> [--loops N] [--headless] [--dump <path>]" << std::endl;
+		return -1;
+	}
+
+	Renderer::GLTracePlayer player;
+	if (!player.load(argv[1])) {
+		return -1;
+	}
+	const unsigned int loopsCount = std::max(1ul, std::stoul(getArgumentValue(argc, argv, "--loops", "100")));
+	const char* dumpPath = getArgumentValue(argc, argv, "--dump", nullptr);
+
+	if (hasArgument(argc, argv, "--headless")) {
+#ifdef BATTLECITY_HEADLESS
+		Renderer::HeadlessContext context;
+		if (!context.init()) {
+			return -1;
+		}
+		return replay(player, loopsCount, dumpPath);
+#else
+		std::cout << "Headless mode is not built, configure with -DBATTLECITY_HEADLESS=ON" << std::endl;
+		return -1;
+#endif
+	}
+
+	if (!glfwInit()) {
+		std::cout << "GLFW is failed!" << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+	// the recording's window size is in its viewport calls, the window only holds the context
+	GLFWwindow* pWindow = glfwCreateWindow(640, 480, "Battle City replay", nullptr, nullptr);
+	if (!pWindow) {
+		std::cout << "glfwCreateWindow is failed!" << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+	glfwMakeContextCurrent(pWindow);
+
+	if (!gladLoadGL()) {
+		std::cout << "Can't load GLAD!" << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	const int result = replay(player, loopsCount, dumpPath);
+	glfwTerminate();
+	return result;
+}
@@ -4,29 +4,425 @@
 #include <glm/vec2.hpp>
 
 #include <iostream>
+#include <algorithm>
 #include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "Game/Game.hpp"
 #include "Resources/ResourceManager.hpp"
+#include "Game/StressScene.hpp"
+#include "Game/ChunkedWorld.hpp"
+#include "Renderer/GLStateCache.hpp"
+#include "Renderer/FrameBuffer.hpp"
+#include "Renderer/GpuProfiler.hpp"
+#include "Renderer/RenderStats.hpp"
+#include "Renderer/GLTraceRecorder.hpp"
+#include "Renderer/ProgramBinaryCache.hpp"
+#include "Renderer/NullBackend.hpp"
+#include "Renderer/SoftwareBackend.hpp"
+#ifdef BATTLECITY_HEADLESS
+#include "Renderer/HeadlessContext.hpp"
+#endif
 
 glm::vec2 g_windowSize(640, 480);
-Game g_game(g_windowSize);
+// created in main, torn down before the render backend by shutdownGame
+std::unique_ptr<Game> g_pGame;
 
 void glfwWindowSizeCallback(GLFWwindow* pWindow, int width, int height) {
 	g_windowSize.x = width;
 	g_windowSize.y = height;
-	glViewport(0, 0, g_windowSize.x, g_windowSize.y);
+	// the viewport is set by the render thread when it presents
+	g_pGame->setWindowSize(g_windowSize);
 }
 
 void glfwKeyCallback(GLFWwindow* pWindow, int key, int scancode, int action, int mode) {
 	if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
 		glfwSetWindowShouldClose(pWindow, GL_TRUE);
 	}
-	g_game.setKey(key, action);
+	// F3 shows the frame rate and the render stats of the last frame over the level
+	if (key == GLFW_KEY_F3 && action == GLFW_PRESS) {
+		g_pGame->setOverlayVisible(!g_pGame->isOverlayVisible());
+	}
+	g_pGame->setKey(key, action);
+}
+
+bool hasArgument(int argc, char** argv, const std::string& argument) {
+	for (int i = 1; i < argc; ++i) {
+		if (argument == argv[i]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+const char* getArgumentValue(int argc, char** argv, const std::string& argument, const char* defaultValue) {
+	for (int i = 1; i + 1 < argc; ++i) {
+		if (argument == argv[i]) {
+			return argv[i + 1];
+		}
+	}
+	return defaultValue;
+}
+
+void printGpuProfile(const Renderer::GpuProfiler& gpuProfiler) {
+	std::cout << "GPU time over " << gpuProfiler.historyFramesCount() << " frames (avg/max ms):";
+	for (size_t pass = 0; pass < Renderer::GpuProfiler::PASSES_COUNT; ++pass) {
+		const auto ePass = static_cast<Renderer::GpuProfiler::EPass>(pass);
+		const auto timing = gpuProfiler.passTiming(ePass);
+		std::cout << " " << Renderer::GpuProfiler::passName(ePass) << " " << timing.averageTime << "/" << timing.maxTime;
+	}
+	const auto frameTiming = gpuProfiler.frameTiming();
+	std::cout << ", frame " << frameTiming.averageTime << "/" << frameTiming.maxTime
+			  << ", dropped " << gpuProfiler.droppedFramesCount() << std::endl;
+}
+
+void saveGpuProfile(int argc, char** argv) {
+	const char* csvPath = getArgumentValue(argc, argv, "--gpu-csv", nullptr);
+	if (csvPath && g_pGame->gpuProfiler() && g_pGame->gpuProfiler()->writeCsv(csvPath)) {
+		std::cout << "Saved the GPU profile to " << csvPath << std::endl;
+	}
+}
+
+// --stats-csv <path> writes the render stats of every frame
+bool openRenderStatsCsv(int argc, char** argv, std::ofstream& file) {
+	const char* csvPath = getArgumentValue(argc, argv, "--stats-csv", nullptr);
+	if (!csvPath) {
+		return false;
+	}
+
+	file.open(csvPath);
+	if (!file.is_open()) {
+		std::cerr << "Can't write render stats: " << csvPath << std::endl;
+		return false;
+	}
+	Renderer::RenderStats::writeCsvHeader(file);
+	return true;
+}
+
+// --record <path> writes a GL trace of the loading, the first frame and
+// --record-frames frames after it, for BattleCityReplayGL
+void startGLTrace(int argc, char** argv) {
+	const char* tracePath = getArgumentValue(argc, argv, "--record", nullptr);
+	if (tracePath && Renderer::GLTraceRecorder::start(tracePath)) {
+		std::cout << "Recording a GL trace to " << tracePath << std::endl;
+	}
+}
+
+void endGLTraceFrame(int argc, char** argv) {
+	if (!Renderer::GLTraceRecorder::isRecording()) {
+		return;
+	}
+
+	Renderer::GLTraceRecorder::endFrame();
+	const unsigned int framesCount = std::stoul(getArgumentValue(argc, argv, "--record-frames", "60"));
+	if (Renderer::GLTraceRecorder::framesCount() > framesCount) {
+		Renderer::GLTraceRecorder::stop();
+		std::cout << "Recorded " << framesCount << " frames of GL trace" << std::endl;
+	}
+}
+
+// Linked shader programs are kept in shader_cache/ next to the executable
+// unless --no-shader-cache is given. Off while recording a GL trace: the
+// trace has to contain the compiles for a replay to build the programs.
+void openProgramBinaryCache(int argc, char** argv) {
+	if (hasArgument(argc, argv, "--no-shader-cache") || Renderer::GLTraceRecorder::isRecording()) {
+		return;
+	}
+	Renderer::ProgramBinaryCache::open(ResourceManager::getExecutableDirectory() + "/shader_cache");
+}
+
+void printProgramBinaryCacheStats() {
+	if (!Renderer::ProgramBinaryCache::isOpen()) {
+		return;
+	}
+	const Renderer::ProgramBinaryCache::Stats& stats = Renderer::ProgramBinaryCache::stats();
+	std::cout << "Shader cache: " << stats.hitsCount << " hits, " << stats.missesCount << " misses (" << stats.rejectedCount << " rejected), "
+			  << "loaded in " << stats.loadTime << " ms, compiled in " << stats.compileTime << " ms, saved " << stats.savedTime << " ms" << std::endl;
+}
+
+// --world <path> plays a world file instead of the built-in level, keeping
+// at most --world-budget megabytes of chunks resident
+bool initGame(int argc, char** argv) {
+	const char* worldPath = getArgumentValue(argc, argv, "--world", "");
+	const size_t worldMemoryBudget = std::stoul(getArgumentValue(argc, argv, "--world-budget", "16")) << 20;
+	return g_pGame->init(worldPath, worldMemoryBudget);
+}
+
+// The game and the loaded resources hold names of the current render
+// backend, so they go first, then the backend while its context is alive.
+void shutdownGame() {
+	g_pGame.reset();
+	ResourceManager::unloadAllResources();
+	Renderer::RenderBackend::setCurrent(nullptr);
+}
+
+// --make-world <path> writes a random world of --world-chunks squared chunks
+int makeWorld(int argc, char** argv) {
+	const char* worldPath = getArgumentValue(argc, argv, "--make-world", nullptr);
+	const unsigned int chunksCount = std::stoul(getArgumentValue(argc, argv, "--world-chunks", "32"));
+	if (!worldPath || !ChunkedWorld::generate(worldPath, chunksCount, chunksCount)) {
+		return -1;
+	}
+	std::cout << "Wrote a world of " << chunksCount * ChunkedWorld::CHUNK_SIZE << "x" << chunksCount * ChunkedWorld::CHUNK_SIZE << " tiles to " << worldPath << std::endl;
+	return 0;
+}
+
+void printWorldStats(const ChunkedWorld& world) {
+	const ChunkedWorld::Stats& stats = world.stats();
+	std::cout << "World " << world.width() << "x" << world.height() << " tiles: "
+			  << stats.residentChunksCount << " chunks resident (" << (stats.residentBytes >> 10) << " of " << (world.memoryBudget() >> 10) << " KB), "
+			  << stats.pendingChunksCount << " pending, " << stats.loadsCount << " loads, " << stats.evictionsCount << " evictions, "
+			  << "load latency avg " << stats.averageLoadLatency() << " ms, max " << stats.maxLoadLatency << " ms" << std::endl;
+}
+
+// pixels are RGBA rows at the native resolution, bottom row first
+bool saveNativeImage(const std::string& path, const unsigned char* pixels) {
+	std::ofstream file(path, std::ios::binary);
+	if (!file.is_open()) {
+		std::cerr << "Can't write image: " << path << std::endl;
+		return false;
+	}
+
+	// binary PPM, top row first
+	file << "P6\n" << Game::NATIVE_WIDTH << " " << Game::NATIVE_HEIGHT << "\n255\n";
+	for (unsigned int row = Game::NATIVE_HEIGHT; row-- > 0;) {
+		for (unsigned int column = 0; column < Game::NATIVE_WIDTH; ++column) {
+			file.write(reinterpret_cast<const char*>(&pixels[4 * (row * Game::NATIVE_WIDTH + column)]), 3);
+		}
+	}
+	return true;
+}
+
+// Runs the usual update/render loop without a window for a fixed number of
+// frames with a fixed time step and reports CPU-side frame times. With
+// --software or --null no GL context is created at all.
+int runHeadless(int argc, char** argv) {
+	const unsigned int framesCount = std::stoul(getArgumentValue(argc, argv, "--frames", "600"));
+	const char* dumpPath = getArgumentValue(argc, argv, "--dump", nullptr);
+	const bool isSoftware = hasArgument(argc, argv, "--software");
+	const bool isNull = hasArgument(argc, argv, "--null");
+	const unsigned int softwareThreadsCount = std::stoul(getArgumentValue(argc, argv, "--threads", "1"));
+	const uint64_t frameDuration = 1000000000 / 60;
+
+#ifdef BATTLECITY_HEADLESS
+	Renderer::HeadlessContext context;
+#endif
+	Renderer::NullBackend* pNullBackend = nullptr;
+	Renderer::SoftwareBackend* pSoftwareBackend = nullptr;
+	if (isNull) {
+		auto pBackend = std::make_unique<Renderer::NullBackend>();
+		pNullBackend = pBackend.get();
+		Renderer::RenderBackend::setCurrent(std::move(pBackend));
+	}
+	else if (isSoftware) {
+		auto pBackend = std::make_unique<Renderer::SoftwareBackend>(Game::NATIVE_WIDTH, Game::NATIVE_HEIGHT, softwareThreadsCount);
+		pSoftwareBackend = pBackend.get();
+		Renderer::RenderBackend::setCurrent(std::move(pBackend));
+	}
+	else {
+#ifdef BATTLECITY_HEADLESS
+		if (!context.init()) {
+			return -1;
+		}
+
+		std::cout << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
+		std::cout << "OpenGL version: " << glGetString(GL_VERSION) << std::endl;
+		glClearColor(0, 0, 0, 0);
+#else
+		std::cout << "Headless OpenGL is not built, configure with -DBATTLECITY_HEADLESS=ON or use --software or --null" << std::endl;
+		return -1;
+#endif
+	}
+	const bool isOpenGL = !isNull && !isSoftware;
+	if (isOpenGL) {
+		startGLTrace(argc, argv);
+	}
+
+	{
+		ResourceManager::setExecutablePath(argv[0]);
+		if (isOpenGL) {
+			openProgramBinaryCache(argc, argv);
+		}
+		if (!initGame(argc, argv)) {
+			shutdownGame();
+			return -1;
+		}
+		printProgramBinaryCacheStats();
+		if (g_pGame->world()) {
+			// pans up and to the right, so chunks stream in and out
+			g_pGame->setKey(GLFW_KEY_RIGHT, GLFW_PRESS);
+			g_pGame->setKey(GLFW_KEY_UP, GLFW_PRESS);
+		}
+		g_pGame->setOverlayVisible(hasArgument(argc, argv, "--overlay"));
+
+		// stands in for the window's default framebuffer
+		std::unique_ptr<Renderer::FrameBuffer> pWindowFrameBuffer;
+		if (!isSoftware) {
+			pWindowFrameBuffer = std::make_unique<Renderer::FrameBuffer>(static_cast<unsigned int>(g_windowSize.x), static_cast<unsigned int>(g_windowSize.y));
+			g_pGame->setOutputFramebuffer(pWindowFrameBuffer->id());
+
+			if (isOpenGL && hasArgument(argc, argv, "--stress")) {
+				pWindowFrameBuffer->bind();
+				StressScene(glm::vec2(Game::NATIVE_WIDTH, Game::NATIVE_HEIGHT)).run({ 1000, 10000, 100000 }, 60);
+			}
+		}
+		if (pNullBackend) {
+			// loading is not part of the frame
+			pNullBackend->resetCounters();
+		}
+		std::ofstream statsFile;
+		const bool isWritingStats = openRenderStatsCsv(argc, argv, statsFile);
+		Renderer::RenderStats::endFrame();
+		// with --render-thread fewer frames are rendered than updated
+		const size_t loadedFramesCount = Renderer::RenderStats::framesCount();
+
+		auto renderFrame = [&]() {
+			if (!isSoftware) {
+				Renderer::GLStateCache::beginFrame();
+				pWindowFrameBuffer->bind();
+				glClear(GL_COLOR_BUFFER_BIT);
+			}
+			g_pGame->render();
+			Renderer::RenderStats::endFrame();
+			if (isWritingStats) {
+				Renderer::RenderStats::writeCsvRow(statsFile, Renderer::RenderStats::lastFrame());
+			}
+			endGLTraceFrame(argc, argv);
+		};
+
+		// with --render-thread a frame costs max(update, render) instead of the sum
+		const bool isRenderThread = hasArgument(argc, argv, "--render-thread");
+		std::thread renderThread;
+		if (isRenderThread) {
+#ifdef BATTLECITY_HEADLESS
+			if (isOpenGL) {
+				context.release();
+			}
+#endif
+			renderThread = std::thread([&]() {
+#ifdef BATTLECITY_HEADLESS
+				if (isOpenGL) {
+					context.makeCurrent();
+				}
+#endif
+				while (g_pGame->waitForSnapshot()) {
+					renderFrame();
+				}
+				Renderer::GLTraceRecorder::stop();
+#ifdef BATTLECITY_HEADLESS
+				if (isOpenGL) {
+					glFinish();
+					context.release();
+				}
+#endif
+			});
+		}
+
+		// knocks out one brick halfway through, so one map chunk is rebuilt
+		const bool isDestroyingBrick = hasArgument(argc, argv, "--destroy-brick");
+		double totalTime = 0.0;
+		double maxTime = 0.0;
+		auto startTime = std::chrono::high_resolution_clock::now();
+		for (unsigned int frame = 0; frame < framesCount; ++frame)
+		{
+			auto frameStartTime = std::chrono::high_resolution_clock::now();
+			if (isDestroyingBrick && frame == framesCount / 2) {
+				g_pGame->setKey(GLFW_KEY_B, GLFW_PRESS);
+				g_pGame->setKey(GLFW_KEY_B, GLFW_RELEASE);
+			}
+			if (!isRenderThread) {
+				// the render thread's counters aren't shared with the update
+				g_pGame->setRenderStats(Renderer::RenderStats::lastFrame());
+			}
+			g_pGame->update(frameDuration);
+
+			if (isRenderThread) {
+				g_pGame->waitUntilSnapshotTaken();
+			}
+			else {
+				renderFrame();
+			}
+
+			const double frameTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - frameStartTime).count();
+			totalTime += frameTime;
+			maxTime = std::max(maxTime, frameTime);
+		}
+		if (isRenderThread) {
+			g_pGame->stopRendering();
+			renderThread.join();
+#ifdef BATTLECITY_HEADLESS
+			if (isOpenGL) {
+				context.makeCurrent();
+			}
+#endif
+		}
+		Renderer::GLTraceRecorder::stop();
+		if (isOpenGL) {
+			glFinish();
+		}
+		const double wallTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+
+		std::cout << "Headless" << (isSoftware ? " software" : isNull ? " null" : "") << (isRenderThread ? " with a render thread" : "") << ": " << framesCount << " frames, "
+				  << "CPU frame time avg " << (framesCount ? totalTime / framesCount : 0.0) << " ms, max " << maxTime << " ms, "
+				  << "wall time" << (isOpenGL ? " with GPU " : " ") << wallTime << " ms" << std::endl;
+
+		std::cout << "Render stats of the last frame: " << Renderer::RenderStats::toString(Renderer::RenderStats::lastFrame()) << std::endl;
+		if (g_pGame->world()) {
+			printWorldStats(*g_pGame->world());
+		}
+		// the software backend draws the level without the chunk buffers
+		if (g_pGame->level() && !isSoftware) {
+			std::cout << "Level map: " << g_pGame->level()->rebuiltChunksCount() << " chunks rebuilt" << std::endl;
+		}
+		// the null backend's queries measure nothing
+		if (g_pGame->gpuProfiler() && isOpenGL) {
+			printGpuProfile(*g_pGame->gpuProfiler());
+			saveGpuProfile(argc, argv);
+		}
+		const size_t renderedFramesCount = Renderer::RenderStats::framesCount() - loadedFramesCount;
+		if (pNullBackend && renderedFramesCount) {
+			std::cout << "GL calls per frame: " << static_cast<double>(pNullBackend->callsCount()) / renderedFramesCount
+					  << " over " << renderedFramesCount << " rendered frames" << std::endl;
+		}
+
+		std::vector<unsigned char> pixels;
+		if (pSoftwareBackend) {
+			const auto& softwarePixels = pSoftwareBackend->renderer().pixels();
+			pixels.assign(reinterpret_cast<const unsigned char*>(softwarePixels.data()),
+						  reinterpret_cast<const unsigned char*>(softwarePixels.data() + softwarePixels.size()));
+		}
+		else if (isOpenGL) {
+			g_pGame->readNativePixels(pixels);
+		}
+		if (dumpPath) {
+			if (pixels.empty()) {
+				std::cout << "The null backend has no image to save" << std::endl;
+			}
+			else if (saveNativeImage(dumpPath, pixels.data())) {
+				std::cout << "Saved the last frame to " << dumpPath << std::endl;
+			}
+		}
+		pWindowFrameBuffer.reset();
+		shutdownGame();
+	}
+	return 0;
 }
 
 int main(int argc, char** argv)
 {
+	if (hasArgument(argc, argv, "--make-world")) {
+		return makeWorld(argc, argv);
+	}
+	g_pGame = std::make_unique<Game>(g_windowSize);
+	if (hasArgument(argc, argv, "--headless")) {
+		return runHeadless(argc, argv);
+	}
+
 	/* Initialize the library */
 	if (!glfwInit()) {
 		std::cout << "GLFW is failed!" << std::endl;
@@ -61,32 +457,86 @@ int main(int argc, char** argv)
 	std::cout << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
 	std::cout << "OpenGL version: " << glGetString(GL_VERSION) << std::endl;
 
+	startGLTrace(argc, argv);
 	glClearColor(0, 0, 0, 0);
 	{
 		ResourceManager::setExecutablePath(argv[0]);
-		g_game.init();
+		openProgramBinaryCache(argc, argv);
+		initGame(argc, argv);
+		printProgramBinaryCacheStats();
+
+		if (hasArgument(argc, argv, "--stress")) {
+			StressScene(glm::vec2(Game::NATIVE_WIDTH, Game::NATIVE_HEIGHT)).run({ 1000, 10000, 100000 }, 60);
+			glfwSetWindowShouldClose(pWindow, GL_TRUE);
+		}
+
+		std::ofstream statsFile;
+		const bool isWritingStats = openRenderStatsCsv(argc, argv, statsFile);
+		Renderer::RenderStats::endFrame();
+
+		// The render thread owns the context from here on and draws the
+		// snapshots the update publishes, so a swap blocked on vsync no longer
+		// holds up the simulation of the next frame.
+		std::mutex renderStatsMutex;
+		Renderer::RenderStats::Counters renderStats{};
+		glfwMakeContextCurrent(nullptr);
+		std::thread renderThread([&]() {
+			glfwMakeContextCurrent(pWindow);
+			while (g_pGame->waitForSnapshot())
+			{
+				/* Render here */
+				Renderer::GLStateCache::beginFrame();
+				glClear(GL_COLOR_BUFFER_BIT);
+
+				g_pGame->render();
+				Renderer::RenderStats::endFrame();
+				if (isWritingStats) {
+					Renderer::RenderStats::writeCsvRow(statsFile, Renderer::RenderStats::lastFrame());
+				}
+				{
+					std::lock_guard<std::mutex> lock(renderStatsMutex);
+					renderStats = Renderer::RenderStats::lastFrame();
+				}
+				endGLTraceFrame(argc, argv);
+
+				/* Swap front and back buffers */
+				glfwSwapBuffers(pWindow);
+			}
+			Renderer::GLTraceRecorder::stop();
+			glfwMakeContextCurrent(nullptr);
+		});
+
 		auto lastTime = std::chrono::high_resolution_clock::now();
 
 		/* Loop until the user closes the window */
 		while (!glfwWindowShouldClose(pWindow))
 		{
+			/* Poll for and process events */
+			glfwPollEvents();
+
 			auto currentTime = std::chrono::high_resolution_clock::now();
 			uint64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(currentTime - lastTime).count();
 			lastTime = currentTime;
-			g_game.update(duration);
-
-			/* Render here */
-			glClear(GL_COLOR_BUFFER_BIT);
+			if (g_pGame->isOverlayVisible()) {
+				std::lock_guard<std::mutex> lock(renderStatsMutex);
+				g_pGame->setRenderStats(renderStats);
+			}
+			g_pGame->update(duration);
 
-			g_game.render();
-
-			/* Swap front and back buffers */
-			glfwSwapBuffers(pWindow);
-
-			/* Poll for and process events */
-			glfwPollEvents();
+			// at most one frame ahead of the render thread
+			g_pGame->waitUntilSnapshotTaken();
+		}
+		g_pGame->stopRendering();
+		renderThread.join();
+		glfwMakeContextCurrent(pWindow);
+		if (g_pGame->gpuProfiler()) {
+			printGpuProfile(*g_pGame->gpuProfiler());
+			saveGpuProfile(argc, argv);
+		}
+		if (g_pGame->world()) {
+			printWorldStats(*g_pGame->world());
 		}
-		ResourceManager::unloadAllResources();
+		shutdownGame();
 	}
     glfwTerminate();
     return 0;